@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace unity
+{
+namespace webrtc
+{
+    // The configuration of the audio device, which is passed from Unity when creating the context.
+    struct AudioConfig
+    {
+        // Pulls the remote audio on the audio thread of Unity when the audio track sinks need it, instead of pulling
+        // it every 10ms on the timer of the audio device.
+        bool pullOnUnityAudioThread = false;
+        // The format of the audio which the audio device pulls every 10ms.
+        int32_t sampleRate = 48000;
+        int32_t channels = 2;
+
+        bool IsValid() const
+        {
+            const bool validRate = sampleRate == 8000 || sampleRate == 16000 || sampleRate == 32000 ||
+                sampleRate == 44100 || sampleRate == 48000;
+            return validRate && (channels == 1 || channels == 2);
+        }
+    };
+} // end namespace webrtc
+} // end namespace unity
@@ -2,6 +2,7 @@
 
 #include <audio/remix_resample.h>
 #include <common_audio/include/audio_util.h>
+#include <rtc_base/time_utils.h>
 
 #include "AudioTrackSinkAdapter.h"
 
@@ -9,12 +10,56 @@ namespace unity
 {
 namespace webrtc
 {
-    AudioTrackSinkAdapter::AudioTrackSinkAdapter()
-        : _buffer(nullptr)
+    constexpr int32_t kDefaultTargetLatencyMs = 30;
+
+    // The rate is adjusted when the smoothed latency is off the target by this, and restored when it comes back
+    // within half of this.
+    constexpr int32_t kRateAdjustmentToleranceMs = 5;
+    constexpr double kSmoothingFactor = 0.05;
+
+    // The margin for the jitter is raised on each underrun, and lowered after no underrun for a while.
+    constexpr int32_t kJitterMarginStepMs = 5;
+    constexpr int32_t kMaxJitterMarginMs = 100;
+    constexpr int32_t kJitterMarginDecaySeconds = 10;
+
+    AudioTrackSinkAdapter::AudioTrackSinkAdapter(ExternalAudioClock* clock)
+        : _producerConfig(nullptr)
+        , _clock(clock)
+        , _clockUs(0)
+        , _clockAligned(false)
+        , _consumerConfig(nullptr)
+        , _started(false)
+        , _smoothedBuffered(0)
+        , _jitterMarginMs(0)
+        , _samplesSinceUnderrun(0)
+        , _pendingConfig(nullptr)
+        , _retiredConfig(nullptr)
+        , _targetLatencyMs(kDefaultTargetLatencyMs)
+        , _rateAdjustment(0)
+        , _underrunCount(0)
+        , _overrunCount(0)
+        , _bufferedMs(0)
+        , _effectiveTargetMs(kDefaultTargetLatencyMs)
     {
     }
 
-    AudioTrackSinkAdapter::~AudioTrackSinkAdapter() { WebRtc_FreeBuffer(_buffer); }
+    AudioTrackSinkAdapter::~AudioTrackSinkAdapter()
+    {
+        // The producer and the consumer have been stopped. The config which the consumer is using may also be held
+        // by the producer or be still pending.
+        Config* configs[] = { _consumerConfig,
+                              _producerConfig,
+                              _pendingConfig.exchange(nullptr),
+                              _retiredConfig.exchange(nullptr) };
+        std::sort(std::begin(configs), std::end(configs));
+        Config* last = nullptr;
+        for (Config* config : configs)
+        {
+            if (config != last)
+                delete config;
+            last = config;
+        }
+    }
 
     void AudioTrackSinkAdapter::OnData(
         const void* audio_data,
@@ -23,10 +68,33 @@ namespace webrtc
         size_t number_of_channels,
         size_t number_of_frames)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        // Adopt the config which the consumer has published.
+        if (Config* config = _pendingConfig.exchange(nullptr, std::memory_order_acquire))
+        {
+            if (_producerConfig)
+            {
+                // The retired config must be deleted before retiring the next one, which rarely happens when Unity
+                // changes the format twice in a row.
+                Config* retired = _retiredConfig.exchange(_producerConfig, std::memory_order_acq_rel);
+                delete retired;
+            }
+            _producerConfig = config;
+
+            // reset audio frame.
+            _frame.num_channels_ = config->channels;
+            _frame.sample_rate_hz_ = config->sampleRate;
+        }
+
+        if (_producerConfig == nullptr)
+            return;
 
-        if (_buffer == nullptr)
+        // Skip the remixing and the resampling when the decoded audio has the format which Unity expects.
+        // The drift is compensated after the resampling, so that the resampler is never re-initialized by it.
+        if (sample_rate == _producerConfig->sampleRate && number_of_channels == _producerConfig->channels)
+        {
+            WriteSamples(static_cast<const int16_t*>(audio_data), number_of_frames, number_of_channels);
             return;
+        }
 
         // note: AudioTrackSinkInterface::OnData method is passed audio data from
         // audio decoder directly, so we need to resample for expected format.
@@ -42,28 +110,92 @@ namespace webrtc
             &_resampler,
             &_frame);
 
-        size_t length = _frame.num_channels() * _frame.samples_per_channel();
+        WriteSamples(_frame.data(), _frame.samples_per_channel(), _frame.num_channels());
+    }
 
-        WebRtc_WriteBuffer(_buffer, _frame.data(), length);
+    void AudioTrackSinkAdapter::WriteSamples(const int16_t* samples, size_t frames, size_t channels)
+    {
+        // Compensate the drift between the clocks of WebRTC and Unity by inserting or dropping one frame in the
+        // middle of each chunk, which is 0.2% of 10ms at 48kHz. The frame is blended with its neighbours, so the
+        // waveform stays continuous.
+        const int32_t adjustment = _rateAdjustment.load(std::memory_order_relaxed);
+        const int16_t* data = samples;
+        size_t length = frames * channels;
+        if (adjustment != 0 && frames >= 2)
+        {
+            const size_t mid = frames / 2;
+            const int16_t* prev = samples + (mid - 1) * channels;
+            const int16_t* next = samples + mid * channels;
+            _driftBuffer.resize((frames + 1) * channels);
+            int16_t* dst = _driftBuffer.data();
+            std::copy(samples, next, dst);
+            if (adjustment > 0)
+            {
+                // Insert the average of the neighbours between them.
+                for (size_t i = 0; i < channels; i++)
+                    dst[mid * channels + i] = static_cast<int16_t>((static_cast<int32_t>(prev[i]) + next[i]) / 2);
+                std::copy(next, samples + length, dst + (mid + 1) * channels);
+                length += channels;
+            }
+            else
+            {
+                // Merge the frame into the previous one.
+                for (size_t i = 0; i < channels; i++)
+                    dst[(mid - 1) * channels + i] =
+                        static_cast<int16_t>((static_cast<int32_t>(prev[i]) + next[i]) / 2);
+                std::copy(next + channels, samples + length, dst + mid * channels);
+                length -= channels;
+            }
+            data = dst;
+        }
+
+        if (_producerConfig->buffer.Write(data, length) < length)
+            _overrunCount.fetch_add(1, std::memory_order_relaxed);
     }
 
-    void AudioTrackSinkAdapter::ResizeBuffer(size_t channels, int32_t sampleRate, size_t length)
+    AudioTrackSinkAdapter::Config*
+    AudioTrackSinkAdapter::CreateConfig(size_t channels, int32_t sampleRate, size_t length)
     {
         RTC_DCHECK(channels);
         RTC_DCHECK(sampleRate);
 
-        // reallocate ring buffer, keep it relatively short at 0.2s
+        Config* config = new Config();
+        config->channels = channels;
+        config->sampleRate = sampleRate;
+        config->length = length;
+
+        // keep the ring buffer relatively short at 0.2s beyond the maximum latency
         size_t bufferSize = static_cast<size_t>(static_cast<float>(channels) * static_cast<float>(sampleRate) * 0.2f);
-        if (_buffer != nullptr)
-            WebRtc_FreeBuffer(_buffer);
-        _buffer = WebRtc_CreateBuffer(bufferSize, sizeof(int16_t));
+        config->buffer.Reset(std::max(bufferSize, length) * 2);
+        return config;
+    }
 
-        // reset audio frame.
-        _frame.num_channels_ = channels;
-        _frame.sample_rate_hz_ = sampleRate;
+    void AudioTrackSinkAdapter::SetTargetLatency(int32_t milliseconds)
+    {
+        RTC_DCHECK_GE(milliseconds, 0);
+        _targetLatencyMs.store(milliseconds, std::memory_order_relaxed);
+    }
+
+    void AudioTrackSinkAdapter::UpdateRateAdjustment(size_t buffered, size_t target, size_t samplesPerMs)
+    {
+        _smoothedBuffered += kSmoothingFactor * (static_cast<double>(buffered) - _smoothedBuffered);
 
-        // reallocate temporary buffer.
-        _bufferIn.resize(length);
+        const double error = _smoothedBuffered - static_cast<double>(target);
+        const double tolerance = static_cast<double>(kRateAdjustmentToleranceMs * samplesPerMs);
+        int32_t adjustment = _rateAdjustment.load(std::memory_order_relaxed);
+        if (error > tolerance)
+            adjustment = -1;
+        else if (error < -tolerance)
+            adjustment = 1;
+        else if (std::abs(error) < tolerance / 2)
+            adjustment = 0;
+        _rateAdjustment.store(adjustment, std::memory_order_relaxed);
+    }
+
+    void AudioTrackSinkAdapter::CollectRetiredConfig()
+    {
+        Config* retired = _retiredConfig.exchange(nullptr, std::memory_order_acquire);
+        delete retired;
     }
 
     void AudioTrackSinkAdapter::ProcessAudio(float* data, size_t length, size_t channels, int32_t sampleRate)
@@ -73,22 +205,83 @@ namespace webrtc
         RTC_DCHECK(channels);
         RTC_DCHECK(sampleRate);
 
-        std::memset(data, 0, sizeof(float) * length);
+        CollectRetiredConfig();
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        // Create a new ring buffer when Unity changes channel count, sample rate,
+        // or data length. The producer switches to it on the next OnData call.
+        if (_consumerConfig == nullptr || _consumerConfig->channels != channels ||
+            _consumerConfig->sampleRate != sampleRate || _consumerConfig->length != length)
+        {
+            _consumerConfig = CreateConfig(channels, sampleRate, length);
+            _started = false;
+            _clockAligned = false;
+            _rateAdjustment.store(0, std::memory_order_relaxed);
+
+            // The config which the producer has not adopted is never used.
+            Config* unused = _pendingConfig.exchange(_consumerConfig, std::memory_order_acq_rel);
+            delete unused;
+        }
 
-        // Reallocate audio buffer when Unity changes channel count, sample rate,
-        // or data length.
-        if (_buffer == nullptr || _frame.num_channels_ != channels || _frame.sample_rate_hz_ != sampleRate ||
-            _bufferIn.size() != length)
+        const size_t samplesPerMs = std::max<size_t>(channels * static_cast<size_t>(sampleRate) / 1000, 1);
+        const int32_t targetMs = _targetLatencyMs.load(std::memory_order_relaxed) + _jitterMarginMs;
+        const size_t target = static_cast<size_t>(targetMs) * samplesPerMs;
+        _effectiveTargetMs.store(targetMs, std::memory_order_relaxed);
+
+        if (_clock)
         {
-            ResizeBuffer(channels, sampleRate, length);
+            // Start from the current time of the audio device, so that the sinks which consume the audio at the same
+            // pace request the same time and the audio is pulled only once for them.
+            if (!_clockAligned)
+            {
+                _clockUs = _clock->PulledTimeUs();
+                _clockAligned = true;
+            }
+            _clockUs += static_cast<int64_t>(length / channels) * rtc::kNumMicrosecsPerSec / sampleRate;
+            _clock->PullUntil(_clockUs + static_cast<int64_t>(targetMs) * rtc::kNumMicrosecsPerMillisec);
         }
 
-        size_t readLength = WebRtc_ReadBuffer(_buffer, nullptr, _bufferIn.data(), length);
+        // Output silence until the samples for the target latency are buffered, at the start and after an
+        // underrun.
+        if (!_started)
+        {
+            if (_consumerConfig->buffer.Size() < length + target)
+            {
+                std::memset(data, 0, sizeof(float) * length);
+                return;
+            }
+            _started = true;
+            _smoothedBuffered = static_cast<double>(target);
+        }
+
+        size_t readLength =
+            _consumerConfig->buffer.Read(length, [data](const int16_t* src, size_t offset, size_t count) {
+                webrtc::S16ToFloat(src, count, data + offset);
+            });
+
+        if (readLength < length)
+        {
+            std::memset(data + readLength, 0, sizeof(float) * (length - readLength));
+            _underrunCount.fetch_add(1, std::memory_order_relaxed);
+
+            // Rebuffer with the larger margin for the jitter.
+            _started = false;
+            _jitterMarginMs = std::min(_jitterMarginMs + kJitterMarginStepMs, kMaxJitterMarginMs);
+            _samplesSinceUnderrun = 0;
+            _rateAdjustment.store(0, std::memory_order_relaxed);
+            _bufferedMs.store(0, std::memory_order_relaxed);
+            return;
+        }
+
+        _samplesSinceUnderrun += length;
+        if (_jitterMarginMs > 0 && _samplesSinceUnderrun >= samplesPerMs * 1000 * kJitterMarginDecaySeconds)
+        {
+            _jitterMarginMs = std::max(_jitterMarginMs - kJitterMarginStepMs, 0);
+            _samplesSinceUnderrun = 0;
+        }
 
-        for (size_t i = 0; i < readLength; i++)
-            data[i] = webrtc::S16ToFloat(_bufferIn[i]);
+        const size_t buffered = _consumerConfig->buffer.Size();
+        _bufferedMs.store(static_cast<int32_t>(buffered / samplesPerMs), std::memory_order_relaxed);
+        UpdateRateAdjustment(buffered, target, samplesPerMs);
     }
 } // end namespace webrtc
 } // end namespace unity
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <vector>
 
 #include <api/audio/audio_frame.h>
 #include <api/media_stream_interface.h>
 #include <common_audio/resampler/include/push_resampler.h>
-#include <common_audio/ring_buffer.h>
+
+#include "SpscRingBuffer.h"
 
 namespace unity
 {
@@ -13,10 +15,29 @@ namespace webrtc
 {
     using namespace ::webrtc;
 
+    // The clock of the audio device which is driven by the audio thread of Unity instead of the timer.
+    class ExternalAudioClock
+    {
+    public:
+        // The time of the audio which has been pulled from the audio device.
+        virtual int64_t PulledTimeUs() const = 0;
+        // Pulls the audio until |timeUs|. The audio is passed to the sinks of the remote audio tracks.
+        virtual void PullUntil(int64_t timeUs) = 0;
+
+    protected:
+        virtual ~ExternalAudioClock() = default;
+    };
+
+    // OnData is called on the audio thread of WebRTC (the producer) and ProcessAudio is called on the audio thread
+    // of Unity (the consumer). The samples are passed through a lock-free ring buffer, so neither thread blocks
+    // the other.
+    // The clocks of both threads drift, so the consumer watches the amount of the buffered samples and asks the
+    // producer to insert or drop a sample frame in each chunk to keep the latency near the target.
     class AudioTrackSinkAdapter : public webrtc::AudioTrackSinkInterface
     {
     public:
-        AudioTrackSinkAdapter();
+        // When |clock| is given, ProcessAudio pulls the audio for the target latency from the audio device.
+        explicit AudioTrackSinkAdapter(ExternalAudioClock* clock = nullptr);
         ~AudioTrackSinkAdapter() override;
 
         void OnData(
@@ -28,15 +49,65 @@ namespace webrtc
 
         void ProcessAudio(float* data, size_t length, size_t channels, int32_t sampleRate);
 
+        // Sets the latency of the samples which are kept in the buffer after each ProcessAudio call. The latency is
+        // raised automatically while underruns occur.
+        void SetTargetLatency(int32_t milliseconds);
+
+        // The number of ProcessAudio calls which could not read enough samples after the playback started.
+        uint64_t GetUnderrunCount() const { return _underrunCount.load(std::memory_order_relaxed); }
+        // The number of OnData calls which dropped samples because the buffer was full.
+        uint64_t GetOverrunCount() const { return _overrunCount.load(std::memory_order_relaxed); }
+        // The latency of the buffered samples after the last ProcessAudio call.
+        int32_t GetBufferedMs() const { return _bufferedMs.load(std::memory_order_relaxed); }
+        // The target latency including the margin for the jitter.
+        int32_t GetTargetLatencyMs() const { return _effectiveTargetMs.load(std::memory_order_relaxed); }
+
     private:
-        void ResizeBuffer(size_t channels, int32_t sampleRate, size_t length);
+        // The format which Unity requests and the ring buffer for it. The consumer creates a new one when the format
+        // is changed, and hands it off to the producer without blocking.
+        struct Config
+        {
+            size_t channels;
+            int32_t sampleRate;
+            size_t length;
+            SpscRingBuffer<int16_t> buffer;
+        };
 
-        AudioFrame _frame;
-        std::mutex _mutex;
-        RingBuffer* _buffer;
-        std::vector<int16_t> _bufferIn;
+        Config* CreateConfig(size_t channels, int32_t sampleRate, size_t length);
+        void CollectRetiredConfig();
+        void UpdateRateAdjustment(size_t buffered, size_t target, size_t samplesPerMs);
+        void WriteSamples(const int16_t* samples, size_t frames, size_t channels);
 
+        // Accessed only by the producer.
+        Config* _producerConfig;
+        AudioFrame _frame;
         PushResampler<int16_t> _resampler;
+        std::vector<int16_t> _driftBuffer;
+
+        // Accessed only by the consumer.
+        ExternalAudioClock* const _clock;
+        // The time of the audio which this sink has consumed on |_clock|.
+        int64_t _clockUs;
+        bool _clockAligned;
+        Config* _consumerConfig;
+        bool _started;
+        double _smoothedBuffered;
+        int32_t _jitterMarginMs;
+        size_t _samplesSinceUnderrun;
+
+        // The config which the consumer published and the producer has not adopted yet.
+        std::atomic<Config*> _pendingConfig;
+        // The config which the producer no longer uses. The consumer deletes it.
+        std::atomic<Config*> _retiredConfig;
+
+        std::atomic<int32_t> _targetLatencyMs;
+        // -1, 0 or 1. The producer drops or inserts a sample frame in each chunk to drain or fill the buffer.
+        std::atomic<int32_t> _rateAdjustment;
+
+        std::atomic<uint64_t> _underrunCount;
+        std::atomic<uint64_t> _overrunCount;
+        std::atomic<int32_t> _bufferedMs;
+        std::atomic<int32_t> _effectiveTargetMs;
     };
 } // end namespace webrtc
 } // end namespace unity
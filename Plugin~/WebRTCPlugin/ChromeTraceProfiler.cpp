@@ -0,0 +1,219 @@
+#include "pch.h"
+
+#include <cstdio>
+#include <rtc_base/time_utils.h>
+#include <sstream>
+
+#include "ChromeTraceProfiler.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // The categories which are created by this profiler follow the built-in categories of Unity.
+    constexpr UnityProfilerCategoryId kFirstCategoryId = 256;
+
+    static std::atomic<uint64_t> s_nextInstanceId(1);
+
+    static void WriteJsonString(std::ostream& out, const std::string& str)
+    {
+        out << '"';
+        for (char c : str)
+        {
+            switch (c)
+            {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    out << escaped;
+                }
+                else
+                {
+                    out << c;
+                }
+            }
+        }
+        out << '"';
+    }
+
+    ChromeTraceProfiler::ChromeTraceProfiler(size_t capacityPerThread)
+        : instanceId_(s_nextInstanceId.fetch_add(1, std::memory_order_relaxed))
+        , capacityPerThread_(capacityPerThread)
+        , enabled_(false)
+        , droppedCount_(0)
+    {
+        RTC_DCHECK_GT(capacityPerThread, 0);
+    }
+
+    ChromeTraceProfiler::~ChromeTraceProfiler() = default;
+
+    ChromeTraceProfiler::ThreadBuffer* ChromeTraceProfiler::GetThreadBuffer()
+    {
+        // Most threads record for one profiler, so the lookup is skipped for it.
+        thread_local uint64_t cachedInstanceId = 0;
+        thread_local ThreadBuffer* cachedBuffer = nullptr;
+        if (cachedInstanceId == instanceId_)
+            return cachedBuffer;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<ThreadBuffer>& buffer = threads_[std::this_thread::get_id()];
+        if (!buffer)
+        {
+            buffer = std::make_unique<ThreadBuffer>();
+            buffer->id = threads_.size();
+            buffer->events.Reset(capacityPerThread_);
+        }
+        cachedInstanceId = instanceId_;
+        cachedBuffer = buffer.get();
+        return cachedBuffer;
+    }
+
+    void ChromeTraceProfiler::BeginSample(const UnityProfilerMarkerDesc* markerDesc)
+    {
+        RTC_DCHECK(markerDesc);
+        GetThreadBuffer()->openSamples.push_back({ markerDesc, rtc::TimeMicros() });
+    }
+
+    void ChromeTraceProfiler::BeginSample(
+        const UnityProfilerMarkerDesc* markerDesc, uint16_t eventDataCount, const UnityProfilerMarkerData* eventData)
+    {
+        // The metadata of the sample is not recorded.
+        BeginSample(markerDesc);
+    }
+
+    void ChromeTraceProfiler::EndSample(const UnityProfilerMarkerDesc* markerDesc)
+    {
+        const int64_t endUs = rtc::TimeMicros();
+        ThreadBuffer* buffer = GetThreadBuffer();
+
+        // The sample which began before the profiler was enabled has no open sample.
+        if (buffer->openSamples.empty() || buffer->openSamples.back().marker != markerDesc)
+            return;
+        const OpenSample sample = buffer->openSamples.back();
+        buffer->openSamples.pop_back();
+
+        const TraceEvent event = { markerDesc, sample.startUs, endUs - sample.startUs };
+        if (buffer->events.Write(&event, 1) == 0)
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int ChromeTraceProfiler::CreateMarker(
+        const UnityProfilerMarkerDesc** desc,
+        const char* name,
+        UnityProfilerCategoryId category,
+        UnityProfilerMarkerFlags flags,
+        int eventDataCount)
+    {
+        RTC_DCHECK(desc);
+        RTC_DCHECK(name);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        markers_.emplace_back();
+        Marker& marker = markers_.back();
+        marker.name = name;
+        marker.desc = UnityProfilerMarkerDesc();
+        marker.desc.id = static_cast<UnityProfilerMarkerId>(markers_.size());
+        marker.desc.flags = flags;
+        marker.desc.categoryId = category;
+        marker.desc.name = marker.name.c_str();
+        *desc = &marker.desc;
+        return 0;
+    }
+
+    int ChromeTraceProfiler::SetMarkerMetadataName(
+        const UnityProfilerMarkerDesc* desc,
+        int index,
+        const char* metadataName,
+        UnityProfilerMarkerDataType metadataType,
+        UnityProfilerMarkerDataUnit metadataUnit)
+    {
+        return 0;
+    }
+
+    int ChromeTraceProfiler::CreateCategory(UnityProfilerCategoryId* category, const char* name, uint32_t unused)
+    {
+        RTC_DCHECK(category);
+        RTC_DCHECK(name);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        *category = static_cast<UnityProfilerCategoryId>(kFirstCategoryId + categories_.size());
+        categories_.push_back(name);
+        return 0;
+    }
+
+    int ChromeTraceProfiler::RegisterThread(UnityProfilerThreadId* threadId, const char* groupName, const char* name)
+    {
+        RTC_DCHECK(threadId);
+        ThreadBuffer* buffer = GetThreadBuffer();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer->name = std::string(groupName) + "." + name;
+        *threadId = buffer->id;
+        return 0;
+    }
+
+    int ChromeTraceProfiler::UnregisterThread(UnityProfilerThreadId threadId)
+    {
+        // The name is kept for the samples which remain in the buffer.
+        return 0;
+    }
+
+    std::string ChromeTraceProfiler::TakeTraceJson()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::ostringstream out;
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        auto separate = [&out, &first]() {
+            if (!first)
+                out << ",\n";
+            first = false;
+        };
+
+        for (const auto& pair : threads_)
+        {
+            const ThreadBuffer& buffer = *pair.second;
+            if (!buffer.name.empty())
+            {
+                separate();
+                out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer.id
+                    << ",\"args\":{\"name\":";
+                WriteJsonString(out, buffer.name);
+                out << "}}";
+            }
+        }
+
+        for (const auto& pair : threads_)
+        {
+            ThreadBuffer& buffer = *pair.second;
+            buffer.events.Read(buffer.events.Size(), [&](const TraceEvent* events, size_t offset, size_t count) {
+                for (size_t i = 0; i < count; i++)
+                {
+                    const TraceEvent& event = events[i];
+                    const size_t category = event.marker->categoryId;
+                    separate();
+                    out << "{\"ph\":\"X\",\"name\":";
+                    WriteJsonString(out, event.marker->name);
+                    out << ",\"cat\":";
+                    if (category >= kFirstCategoryId && category - kFirstCategoryId < categories_.size())
+                        WriteJsonString(out, categories_[category - kFirstCategoryId]);
+                    else
+                        out << "\"Unity\"";
+                    out << ",\"pid\":1,\"tid\":" << buffer.id << ",\"ts\":" << event.startUs
+                        << ",\"dur\":" << event.durationUs << "}";
+                }
+            });
+        }
+        out << "],\"displayTimeUnit\":\"ms\"}";
+        return out.str();
+    }
+} // end namespace webrtc
+} // end namespace unity
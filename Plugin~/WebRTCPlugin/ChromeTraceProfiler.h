@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "SpscRingBuffer.h"
+#include "UnityProfilerInterfaceFunctions.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // The profiler which records the samples in the Chrome trace event format instead of passing them to Unity. It
+    // is used through ProfilerMarkerFactory like the Unity profiler, so the native pipeline can be profiled in the
+    // test binaries and in the players which do not have the Unity profiler. The trace is viewed in
+    // chrome://tracing or Perfetto.
+    //
+    // Each thread records the samples into its own lock-free buffer, so the recording threads never block each
+    // other. The mutex is taken only when a thread records for the first time, when a marker is created and when the
+    // trace is taken.
+    class ChromeTraceProfiler : public UnityProfiler
+    {
+    public:
+        static constexpr size_t kDefaultCapacityPerThread = 64 * 1024;
+
+        explicit ChromeTraceProfiler(size_t capacityPerThread = kDefaultCapacityPerThread);
+        ~ChromeTraceProfiler() override;
+
+        // The samples are recorded only while enabled. It is disabled initially.
+        void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+        // Moves the recorded samples out of the buffers and returns them as a JSON trace. The names of the threads
+        // are included in each trace, so each one can be opened separately.
+        std::string TakeTraceJson();
+
+        // The number of the samples which were dropped because the buffer of the thread was full.
+        uint64_t GetDroppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+
+        void BeginSample(const UnityProfilerMarkerDesc* markerDesc) override;
+        void BeginSample(
+            const UnityProfilerMarkerDesc* markerDesc,
+            uint16_t eventDataCount,
+            const UnityProfilerMarkerData* eventData) override;
+        void EndSample(const UnityProfilerMarkerDesc* markerDesc) override;
+        int IsAvailable() override { return enabled_.load(std::memory_order_relaxed); }
+        int CreateMarker(
+            const UnityProfilerMarkerDesc** desc,
+            const char* name,
+            UnityProfilerCategoryId category,
+            UnityProfilerMarkerFlags flags,
+            int eventDataCount) override;
+        int SetMarkerMetadataName(
+            const UnityProfilerMarkerDesc* desc,
+            int index,
+            const char* metadataName,
+            UnityProfilerMarkerDataType metadataType,
+            UnityProfilerMarkerDataUnit metadataUnit) override;
+        int CreateCategory(UnityProfilerCategoryId* category, const char* name, uint32_t unused) override;
+        int RegisterThread(UnityProfilerThreadId* threadId, const char* groupName, const char* name) override;
+        int UnregisterThread(UnityProfilerThreadId threadId) override;
+
+    private:
+        // The sample is recorded when it ends, as the complete event which has the duration.
+        struct TraceEvent
+        {
+            const UnityProfilerMarkerDesc* marker;
+            int64_t startUs;
+            int64_t durationUs;
+        };
+
+        struct OpenSample
+        {
+            const UnityProfilerMarkerDesc* marker;
+            int64_t startUs;
+        };
+
+        struct ThreadBuffer
+        {
+            UnityProfilerThreadId id;
+            // Guarded by |mutex_|.
+            std::string name;
+            // Written by the thread and read by TakeTraceJson.
+            SpscRingBuffer<TraceEvent> events;
+            // Accessed only by the thread.
+            std::vector<OpenSample> openSamples;
+        };
+
+        struct Marker
+        {
+            UnityProfilerMarkerDesc desc;
+            std::string name;
+        };
+
+        ThreadBuffer* GetThreadBuffer();
+
+        // Distinguishes the instances for the buffer which is cached per thread.
+        const uint64_t instanceId_;
+        const size_t capacityPerThread_;
+        std::atomic<bool> enabled_;
+        std::atomic<uint64_t> droppedCount_;
+
+        std::mutex mutex_;
+        // The thread id may be reused by the new thread after the thread exits, which takes over the buffer.
+        std::unordered_map<std::thread::id, std::unique_ptr<ThreadBuffer>> threads_;
+        // std::deque does not move the elements on push_back, so the descriptions are passed by the pointer.
+        std::deque<Marker> markers_;
+        std::vector<std::string> categories_;
+    };
+} // end namespace webrtc
+} // end namespace unity
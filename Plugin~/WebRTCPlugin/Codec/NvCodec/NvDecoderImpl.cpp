@@ -33,6 +33,7 @@ namespace webrtc
         , m_decodedCompleteCallback(nullptr)
         , m_buffer_pool(false)
         , m_profiler(profiler)
+        , m_metrics(MetricsRegistry::GetInstance().Register("decoder"))
     {
         if (profiler)
             m_marker = profiler->CreateMarker(
@@ -97,6 +98,8 @@ namespace webrtc
 
     int32_t NvDecoderImpl::Decode(const EncodedImage& input_image, bool missing_frames, int64_t render_time_ms)
     {
+        ScopedLatency latency(m_metrics.get(), PipelineStage::kDecode);
+
         CUcontext current;
         if (!ck(cuCtxGetCurrent(&current)))
         {
@@ -7,6 +7,7 @@
 
 #include "NvCodec.h"
 #include "NvDecoder/NvDecoder.h"
+#include "PipelineMetrics.h"
 
 using namespace webrtc;
 
@@ -52,6 +53,7 @@ namespace webrtc
 
         ProfilerMarkerFactory* m_profiler;
         const UnityProfilerMarkerDesc* m_marker;
+        std::shared_ptr<TrackMetrics> m_metrics;
     };
 
 } // end namespace webrtc
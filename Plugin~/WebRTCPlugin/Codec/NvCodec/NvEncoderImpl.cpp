@@ -6,6 +6,7 @@
 #include <common_video/h264/h264_common.h>
 #include <media/base/media_constants.h>
 #include <modules/video_coding/include/video_codec_interface.h>
+#include <third_party/libyuv/include/libyuv/scale_argb.h>
 
 #include "Codec/H264ProfileLevelId.h"
 #include "Codec/NvCodec/NvEncoderCudaWithCUarray.h"
@@ -86,12 +87,14 @@ namespace webrtc
         : m_context(context)
         , m_memoryType(memoryType)
         , m_scaledArray(nullptr)
+        , m_loggedHostScale(false)
         , m_encoder(nullptr)
         , m_format(format)
         , m_encodedCompleteCallback(nullptr)
         , m_encode_fps(1000, 1000)
         , m_clock(Clock::GetRealTimeClock())
         , m_profiler(profiler)
+        , m_metrics(MetricsRegistry::GetInstance().Register("encoder"))
     {
         RTC_CHECK(absl::EqualsIgnoreCase(codec.name, cricket::kH264CodecName));
         // not implemented for host memory
@@ -280,7 +283,7 @@ namespace webrtc
         return WEBRTC_VIDEO_CODEC_OK;
     }
 
-    void NvEncoderImpl::Resize(const CUarray& src, CUarray& dst, const Size& size)
+    void NvEncoderImpl::Resize(const CUarray& src, CUarray& dst, const Rect& crop, const Size& size)
     {
         CUDA_ARRAY_DESCRIPTOR srcDesc = {};
         CUresult result = cuArrayGetDescriptor(&srcDesc, src);
@@ -331,11 +334,101 @@ namespace webrtc
                 return;
             }
         }
+
+        // Copy the pixels in the crop rectangle. The caller scales on the host when the sizes are different.
+        RTC_DCHECK_EQ(crop.size(), size);
+
+        const size_t bytesPerPixel = srcDesc.NumChannels;
+        CUDA_MEMCPY2D copy = {};
+        copy.srcMemoryType = CU_MEMORYTYPE_ARRAY;
+        copy.srcArray = src;
+        copy.srcXInBytes = static_cast<size_t>(crop.x()) * bytesPerPixel;
+        copy.srcY = static_cast<size_t>(crop.y());
+        copy.dstMemoryType = CU_MEMORYTYPE_ARRAY;
+        copy.dstArray = dst;
+        copy.WidthInBytes = static_cast<size_t>(crop.width()) * bytesPerPixel;
+        copy.Height = static_cast<size_t>(crop.height());
+        result = cuMemcpy2D(&copy);
+        if (result != CUDA_SUCCESS)
+        {
+            RTC_LOG(LS_ERROR) << "cuMemcpy2D failed. error:" << result;
+        }
+    }
+
+    bool NvEncoderImpl::CropAndScaleOnHost(
+        const GpuMemoryBufferCudaHandle* handle,
+        const Size& bufferSize,
+        const Rect& crop,
+        const Size& size,
+        CUcontext context,
+        CUmemorytype memoryType)
+    {
+        // Scaling a CUDA resource needs a CUDA kernel, which this plugin does not build. Read the crop rectangle back
+        // to the host and scale it with libyuv instead. The encoder input has 4 bytes per pixel, and scaling each
+        // channel independently does not depend on the order of the channels.
+        if (!m_loggedHostScale)
+        {
+            RTC_LOG(LS_WARNING) << "Scaling the frame from " << crop.width() << "x" << crop.height() << " to "
+                                << size.width() << "x" << size.height()
+                                << " on the CPU. The frame is copied to the host and back on each encode.";
+            m_loggedHostScale = true;
+        }
+
+        const int kBytesPerPixel = 4;
+        const size_t cropPitch = static_cast<size_t>(crop.width()) * kBytesPerPixel;
+        const size_t scaledPitch = static_cast<size_t>(size.width()) * kBytesPerPixel;
+        m_cropHost.resize(cropPitch * static_cast<size_t>(crop.height()));
+        m_scaledHost.resize(scaledPitch * static_cast<size_t>(size.height()));
+
+        CUDA_MEMCPY2D copy = {};
+        copy.srcMemoryType = memoryType;
+        if (memoryType == CU_MEMORYTYPE_DEVICE)
+        {
+            copy.srcDevice = handle->mappedPtr;
+            copy.srcPitch = static_cast<size_t>(bufferSize.width()) * kBytesPerPixel;
+        }
+        else
+        {
+            copy.srcArray = handle->mappedArray;
+        }
+        copy.srcXInBytes = static_cast<size_t>(crop.x()) * kBytesPerPixel;
+        copy.srcY = static_cast<size_t>(crop.y());
+        copy.dstMemoryType = CU_MEMORYTYPE_HOST;
+        copy.dstHost = m_cropHost.data();
+        copy.dstPitch = cropPitch;
+        copy.WidthInBytes = cropPitch;
+        copy.Height = static_cast<size_t>(crop.height());
+
+        CUresult result = cuCtxPushCurrent(context);
+        if (result != CUDA_SUCCESS)
+        {
+            RTC_LOG(LS_ERROR) << "cuCtxPushCurrent failed. error:" << result;
+            return false;
+        }
+        result = cuMemcpy2D(&copy);
+        cuCtxPopCurrent(nullptr);
+        if (result != CUDA_SUCCESS)
+        {
+            RTC_LOG(LS_ERROR) << "cuMemcpy2D failed. error:" << result;
+            return false;
+        }
+
+        return libyuv::ARGBScale(
+                   m_cropHost.data(),
+                   static_cast<int>(cropPitch),
+                   crop.width(),
+                   crop.height(),
+                   m_scaledHost.data(),
+                   static_cast<int>(scaledPitch),
+                   size.width(),
+                   size.height(),
+                   libyuv::kFilterBox) == 0;
     }
 
     bool NvEncoderImpl::CopyResource(
         const NvEncInputFrame* encoderInputFrame,
         GpuMemoryBufferInterface* buffer,
+        const Rect& crop,
         Size& size,
         CUcontext context,
         CUmemorytype memoryType)
@@ -351,12 +444,51 @@ namespace webrtc
             return false;
         }
 
-        if (memoryType == CU_MEMORYTYPE_DEVICE)
+        if (crop.size() != size)
         {
+            if (!CropAndScaleOnHost(handle, buffer->GetSize(), crop, size, context, memoryType))
+                return false;
+            if (memoryType == CU_MEMORYTYPE_DEVICE)
+            {
+                NvEncoderCuda::CopyToDeviceFrame(
+                    context,
+                    m_scaledHost.data(),
+                    0,
+                    reinterpret_cast<CUdeviceptr>(encoderInputFrame->inputPtr),
+                    encoderInputFrame->pitch,
+                    size.width(),
+                    size.height(),
+                    CU_MEMORYTYPE_HOST,
+                    encoderInputFrame->bufferFormat,
+                    encoderInputFrame->chromaOffsets,
+                    encoderInputFrame->numChromaPlanes);
+            }
+            else if (memoryType == CU_MEMORYTYPE_ARRAY)
+            {
+                NvEncoderCudaWithCUarray::CopyToDeviceFrame(
+                    context,
+                    m_scaledHost.data(),
+                    0,
+                    static_cast<CUarray>(encoderInputFrame->inputPtr),
+                    encoderInputFrame->pitch,
+                    size.width(),
+                    size.height(),
+                    CU_MEMORYTYPE_HOST,
+                    encoderInputFrame->bufferFormat,
+                    encoderInputFrame->chromaOffsets,
+                    encoderInputFrame->numChromaPlanes);
+            }
+        }
+        else if (memoryType == CU_MEMORYTYPE_DEVICE)
+        {
+            // Start reading from the top-left of the crop rectangle with the pitch of the whole buffer.
+            const int kBytesPerPixel = 4;
+            const int srcPitch = buffer->GetSize().width() * kBytesPerPixel;
+            const CUdeviceptr srcPtr = handle->mappedPtr + crop.y() * srcPitch + crop.x() * kBytesPerPixel;
             NvEncoderCuda::CopyToDeviceFrame(
                 context,
-                reinterpret_cast<void*>(handle->mappedPtr),
-                0,
+                reinterpret_cast<void*>(srcPtr),
+                srcPitch,
                 reinterpret_cast<CUdeviceptr>(encoderInputFrame->inputPtr),
                 encoderInputFrame->pitch,
                 size.width(),
@@ -370,11 +502,11 @@ namespace webrtc
         {
             void* pSrcArray = static_cast<void*>(handle->mappedArray);
 
-            // Resize cuda array when the resolution of input buffer is different from output one.
+            // Copy the crop rectangle into another cuda array when the frame is cropped.
             // The output buffer named m_scaledArray is reused while the resolution is matched.
-            if (buffer->GetSize() != size)
+            if (crop != Rect(buffer->GetSize()))
             {
-                Resize(handle->mappedArray, m_scaledArray, size);
+                Resize(handle->mappedArray, m_scaledArray, crop, size);
                 pSrcArray = static_cast<void*>(m_scaledArray);
             }
 
@@ -414,10 +546,29 @@ namespace webrtc
             ? static_cast<VideoFrameAdapter::ScaledBuffer*>(videoFrameBuffer)->GetVideoFrame()
             : static_cast<VideoFrameAdapter*>(videoFrameBuffer)->GetVideoFrame();
 
+        // The encoder does not know the track, so it takes the track of the source of the frames. The labels are
+        // unique in the registry, so the track id is copied only when the source changes.
+        const VideoFrameAdapter* adapter = videoFrameBuffer->scaled()
+            ? static_cast<VideoFrameAdapter::ScaledBuffer*>(videoFrameBuffer)->parent()
+            : static_cast<VideoFrameAdapter*>(videoFrameBuffer);
+        const TrackMetrics* sourceMetrics = adapter->metrics();
+        if (sourceMetrics && sourceMetrics->label() != m_sourceLabel)
+        {
+            std::string trackId = sourceMetrics->trackId();
+            if (!trackId.empty())
+            {
+                m_metrics->SetTrackId(trackId);
+                m_sourceLabel = sourceMetrics->label();
+            }
+        }
+
         if (!video_frame)
         {
             return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
         }
+        const Rect crop = videoFrameBuffer->scaled()
+            ? static_cast<VideoFrameAdapter::ScaledBuffer*>(videoFrameBuffer)->crop()
+            : Rect(video_frame->size());
 
         bool send_key_frame = false;
         if (m_configurations[0].key_frame_request && m_configurations[0].sending)
@@ -433,25 +584,28 @@ namespace webrtc
 
         Size encodeSize(m_encoder->GetEncodeWidth(), m_encoder->GetEncodeHeight());
 
-        const NvEncInputFrame* encoderInputFrame = m_encoder->GetNextInputFrame();
+        std::vector<std::vector<uint8_t>> vPacket;
+        {
+            ScopedLatency latency(m_metrics.get(), PipelineStage::kEncode);
+            const NvEncInputFrame* encoderInputFrame = m_encoder->GetNextInputFrame();
 
-        // Copy CUDA buffer in VideoFrame to encoderInputFrame.
-        auto buffer = video_frame->GetGpuMemoryBuffer();
-        if (!CopyResource(encoderInputFrame, buffer, encodeSize, m_context, m_memoryType))
-            return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+            // Copy CUDA buffer in VideoFrame to encoderInputFrame.
+            auto buffer = video_frame->GetGpuMemoryBuffer();
+            if (!CopyResource(encoderInputFrame, buffer, crop, encodeSize, m_context, m_memoryType))
+                return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
 
-        NV_ENC_PIC_PARAMS picParams = NV_ENC_PIC_PARAMS();
-        picParams.version = NV_ENC_PIC_PARAMS_VER;
-        picParams.encodePicFlags = 0;
-        if (send_key_frame)
-        {
-            picParams.encodePicFlags =
-                NV_ENC_PIC_FLAG_FORCEINTRA | NV_ENC_PIC_FLAG_FORCEIDR | NV_ENC_PIC_FLAG_OUTPUT_SPSPPS;
-            m_configurations[0].key_frame_request = false;
-        }
+            NV_ENC_PIC_PARAMS picParams = NV_ENC_PIC_PARAMS();
+            picParams.version = NV_ENC_PIC_PARAMS_VER;
+            picParams.encodePicFlags = 0;
+            if (send_key_frame)
+            {
+                picParams.encodePicFlags =
+                    NV_ENC_PIC_FLAG_FORCEINTRA | NV_ENC_PIC_FLAG_FORCEIDR | NV_ENC_PIC_FLAG_OUTPUT_SPSPPS;
+                m_configurations[0].key_frame_request = false;
+            }
 
-        std::vector<std::vector<uint8_t>> vPacket;
-        m_encoder->EncodeFrame(vPacket, &picParams);
+            m_encoder->EncodeFrame(vPacket, &picParams);
+        }
 
         for (std::vector<uint8_t>& packet : vPacket)
         {
@@ -502,6 +656,8 @@ namespace webrtc
         codecInfo.codecType = kVideoCodecH264;
         codecInfo.codecSpecific.H264.packetization_mode = H264PacketizationMode::NonInterleaved;
 
+        // WebRTC packetizes the image in this call.
+        ScopedLatency latency(m_metrics.get(), PipelineStage::kPacketize);
         const auto result = m_encodedCompleteCallback->OnEncodedImage(m_encodedImage, &codecInfo);
         if (result.error != EncodedImageCallback::Result::OK)
         {
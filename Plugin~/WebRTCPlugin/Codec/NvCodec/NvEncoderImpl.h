@@ -11,6 +11,7 @@
 
 #include "NvCodec.h"
 #include "NvEncoder/NvEncoderCuda.h"
+#include "PipelineMetrics.h"
 #include "Size.h"
 
 namespace unity
@@ -25,6 +26,7 @@ namespace webrtc
     class ProfilerMarkerFactory;
     struct GpuMemoryBufferHandle;
     class GpuMemoryBufferInterface;
+    struct GpuMemoryBufferCudaHandle;
     class NvEncoderImpl : public unity::webrtc::NvEncoder
     {
     public:
@@ -75,15 +77,32 @@ namespace webrtc
         bool CopyResource(
             const NvEncInputFrame* encoderInputFrame,
             GpuMemoryBufferInterface* buffer,
+            const Rect& crop,
             Size& size,
             CUcontext context,
             CUmemorytype memoryType);
 
-        void Resize(const CUarray& src, CUarray& dst, const Size& size);
+        void Resize(const CUarray& src, CUarray& dst, const Rect& crop, const Size& size);
+        // Crops and scales the frame into m_scaledHost on the CPU.
+        bool CropAndScaleOnHost(
+            const GpuMemoryBufferCudaHandle* handle,
+            const Size& bufferSize,
+            const Rect& crop,
+            const Size& size,
+            CUcontext context,
+            CUmemorytype memoryType);
 
         CUcontext m_context;
         CUmemorytype m_memoryType;
         CUarray m_scaledArray;
+        // The staging buffers of CropAndScaleOnHost. Each scaled frame costs a device to host copy of the crop
+        // rectangle, a CPU scale and a host to device copy of the result, which is a few milliseconds for 1080p and
+        // stalls the encode thread on the copies. The plugin links only the CUDA driver API and builds no kernels, so
+        // there is no GPU scaler to use instead.
+        std::vector<uint8_t> m_cropHost;
+        std::vector<uint8_t> m_scaledHost;
+        // Whether the fallback to CropAndScaleOnHost has been logged.
+        bool m_loggedHostScale;
         std::unique_ptr<NvEncoderInternal> m_encoder;
 
         VideoCodec m_codec;
@@ -105,6 +124,9 @@ namespace webrtc
         const UnityProfilerMarkerDesc* m_marker;
 
         std::vector<LayerConfig> m_configurations;
+        std::shared_ptr<TrackMetrics> m_metrics;
+        // The label of the source metrics whose track id has been copied to |m_metrics|.
+        std::string m_sourceLabel;
 
         static absl::optional<webrtc::H264Level> s_maxSupportedH264Level;
         static std::vector<SdpVideoFormat> s_formats;
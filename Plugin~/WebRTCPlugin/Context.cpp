@@ -7,10 +7,12 @@
 
 #include "AudioTrackSinkAdapter.h"
 #include "Context.h"
+#include "DemuxAudioMixer.h"
 #include "EncodedStreamTransformer.h"
 #include "GraphicsDevice/GraphicsUtility.h"
 #include "GraphicsDevice/IGraphicsDevice.h"
 #include "MediaStreamObserver.h"
+#include "StatsSnapshot.h"
 #include "UnityAudioDecoderFactory.h"
 #include "UnityAudioEncoderFactory.h"
 #include "UnityAudioTrackSource.h"
@@ -151,14 +153,16 @@ namespace webrtc
         : m_workerThread(rtc::Thread::CreateWithSocketServer())
         , m_signalingThread(rtc::Thread::CreateWithSocketServer())
         , m_taskQueueFactory(CreateDefaultTaskQueueFactory())
+        , m_audioConfig(dependencies.audio)
     {
         m_workerThread->Start();
         m_signalingThread->Start();
 
         rtc::InitializeSSL();
 
-        m_audioDevice = m_workerThread->BlockingCall(
-            [&]() { return rtc::make_ref_counted<DummyAudioDevice>(m_taskQueueFactory.get()); });
+        m_audioDevice = m_workerThread->BlockingCall([&]() {
+            return rtc::make_ref_counted<DummyAudioDevice>(m_taskQueueFactory.get(), m_audioConfig);
+        });
 
         std::unique_ptr<webrtc::VideoEncoderFactory> videoEncoderFactory =
             std::make_unique<UnityVideoEncoderFactory>(dependencies.device, dependencies.profiler);
@@ -169,6 +173,9 @@ namespace webrtc
         rtc::scoped_refptr<AudioEncoderFactory> audioEncoderFactory = CreateAudioEncoderFactory();
         rtc::scoped_refptr<AudioDecoderFactory> audioDecoderFactory = CreateAudioDecoderFactory();
 
+        // The mixed audio is not used, so the remote audio streams are only pulled for their sinks.
+        rtc::scoped_refptr<AudioMixer> audioMixer = DemuxAudioMixer::Create(m_audioDevice->SamplingRate());
+
         m_peerConnectionFactory = CreatePeerConnectionFactory(
             m_workerThread.get(),
             m_workerThread.get(),
@@ -178,7 +185,7 @@ namespace webrtc
             audioDecoderFactory,
             std::move(videoEncoderFactory),
             std::move(videoDecoderFactory),
-            nullptr,
+            audioMixer,
             nullptr);
     }
 
@@ -189,6 +196,7 @@ namespace webrtc
 
             m_peerConnectionFactory = nullptr;
             m_workerThread->BlockingCall([this]() { m_audioDevice = nullptr; });
+            m_mapStatsSamplers.clear();
             m_mapClients.clear();
 
             // check count of refptr to avoid to forget disposing
@@ -260,7 +268,9 @@ namespace webrtc
 
     AudioTrackSinkAdapter* Context::CreateAudioTrackSinkAdapter()
     {
-        auto sink = std::make_unique<AudioTrackSinkAdapter>();
+        // The sink pulls the audio from the audio device when the audio thread of Unity drives the audio device.
+        ExternalAudioClock* clock = m_audioConfig.pullOnUnityAudioThread ? m_audioDevice.get() : nullptr;
+        auto sink = std::make_unique<AudioTrackSinkAdapter>(clock);
         AudioTrackSinkAdapter* ptr = sink.get();
         m_mapAudioTrackAndSink.emplace(ptr, std::move(sink));
         return ptr;
@@ -274,7 +284,8 @@ namespace webrtc
         m_listStatsReport.push_back(report);
     }
 
-    const RTCStats** Context::GetStatsList(const RTCStatsReport* report, size_t* length, uint32_t** types)
+    const RTCStats**
+    Context::GetStatsList(const RTCStatsReport* report, size_t* length, uint32_t** types, uint32_t typeMask)
     {
         std::lock_guard<std::mutex> lock(mutexStatsReport);
 
@@ -290,24 +301,60 @@ namespace webrtc
         }
 
         const size_t size = report->size();
-        *length = size;
         *types = static_cast<uint32_t*>(CoTaskMemAlloc(sizeof(uint32_t) * size));
         void* buf = CoTaskMemAlloc(sizeof(RTCStats*) * size);
         const RTCStats** ret = static_cast<const RTCStats**>(buf);
-        if (size == 0)
-        {
-            return ret;
-        }
-        int i = 0;
+        size_t i = 0;
         for (const auto& stats : *report)
         {
+            // The stats of the unknown type are skipped because Unity cannot handle them.
+            const uint32_t type = GetStatsType(stats.type());
+            if (type == kUnknownStatsType || (typeMask & (1u << type)) == 0)
+                continue;
             ret[i] = &stats;
-            (*types)[i] = statsTypes.at(stats.type());
+            (*types)[i] = type;
             i++;
         }
+        *length = i;
         return ret;
     }
 
+    uint8_t* Context::GetStatsSnapshot(const RTCStatsReport* report, size_t* length, uint32_t typeMask)
+    {
+        std::lock_guard<std::mutex> lock(mutexStatsReport);
+
+        auto result = std::find_if(
+            m_listStatsReport.begin(),
+            m_listStatsReport.end(),
+            [report](rtc::scoped_refptr<const webrtc::RTCStatsReport> it) { return it.get() == report; });
+
+        if (result == m_listStatsReport.end())
+        {
+            RTC_LOG(LS_INFO) << "Calling GetStatsSnapshot is failed. The reference of RTCStatsReport is not found.";
+            return nullptr;
+        }
+
+        StatsSnapshotWriter writer;
+        const std::vector<uint8_t> snapshot = writer.Write(*report, typeMask);
+        *length = snapshot.size();
+        uint8_t* ret = static_cast<uint8_t*>(CoTaskMemAlloc(snapshot.size()));
+        std::memcpy(ret, snapshot.data(), snapshot.size());
+        return ret;
+    }
+
+    void Context::StartStatsSampler(PeerConnectionObject* obj, TimeDelta interval)
+    {
+        std::unique_ptr<StatsSampler>& sampler = m_mapStatsSamplers[obj];
+        if (!sampler)
+        {
+            sampler = std::make_unique<StatsSampler>(
+                obj, obj->connection.get(), m_signalingThread.get(), &m_statsSampleBuffer);
+        }
+        sampler->Start(interval);
+    }
+
+    void Context::StopStatsSampler(PeerConnectionObject* obj) { m_mapStatsSamplers.erase(obj); }
+
     void Context::DeleteStatsReport(const webrtc::RTCStatsReport* report)
     {
         std::lock_guard<std::mutex> lock(mutexStatsReport);
@@ -342,7 +389,7 @@ namespace webrtc
 
     void Context::AddDataChannel(rtc::scoped_refptr<DataChannelInterface> channel, PeerConnectionObject& pc)
     {
-        auto dataChannelObj = std::make_unique<DataChannelObject>(channel, pc);
+        auto dataChannelObj = std::make_unique<DataChannelObject>(channel, pc, m_signalingThread.get());
         m_mapDataChannels[channel.get()] = std::move(dataChannelObj);
     }
 
@@ -375,7 +422,11 @@ namespace webrtc
         return ptr;
     }
 
-    void Context::DeletePeerConnection(PeerConnectionObject* obj) { m_mapClients.erase(obj); }
+    void Context::DeletePeerConnection(PeerConnectionObject* obj)
+    {
+        m_mapStatsSamplers.erase(obj);
+        m_mapClients.erase(obj);
+    }
 
     uint32_t Context::s_rendererId = 0;
     uint32_t Context::GenerateRendererId() { return s_rendererId++; }
@@ -2,10 +2,13 @@
 
 #include <mutex>
 
+#include "AudioConfig.h"
 #include "AudioTrackSinkAdapter.h"
 #include "DummyAudioDevice.h"
 #include "GraphicsDevice/IGraphicsDevice.h"
 #include "PeerConnectionObject.h"
+#include "StatsTypes.h"
+#include "StatsSampler.h"
 #include "UnityVideoRenderer.h"
 #include "UnityVideoTrackSource.h"
 
@@ -15,34 +18,13 @@ namespace webrtc
 {
     using namespace ::webrtc;
 
-    const std::map<std::string, uint32_t> statsTypes = { { "codec", 0 },
-                                                         { "inbound-rtp", 1 },
-                                                         { "outbound-rtp", 2 },
-                                                         { "remote-inbound-rtp", 3 },
-                                                         { "remote-outbound-rtp", 4 },
-                                                         { "media-source", 5 },
-                                                         { "csrc", 6 },
-                                                         { "peer-connection", 7 },
-                                                         { "data-channel", 8 },
-                                                         { "stream", 9 },
-                                                         { "track", 10 },
-                                                         { "transceiver", 11 },
-                                                         { "sender", 12 },
-                                                         { "receiver", 13 },
-                                                         { "transport", 14 },
-                                                         { "sctp-transport", 15 },
-                                                         { "candidate-pair", 16 },
-                                                         { "local-candidate", 17 },
-                                                         { "remote-candidate", 18 },
-                                                         { "certificate", 19 },
-                                                         { "ice-server", 20 } };
-
     class IGraphicsDevice;
     class ProfilerMarkerFactory;
     struct ContextDependencies
     {
         IGraphicsDevice* device;
         ProfilerMarkerFactory* profiler;
+        AudioConfig audio;
     };
 
     class Context;
@@ -127,9 +109,19 @@ namespace webrtc
         // StatsReport
         std::mutex mutexStatsReport;
         void AddStatsReport(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report);
-        const RTCStats** GetStatsList(const RTCStatsReport* report, size_t* length, uint32_t** types);
+        // Returns the stats of the types in |typeMask|. The bit of each type is |1 << type|.
+        const RTCStats** GetStatsList(
+            const RTCStatsReport* report, size_t* length, uint32_t** types, uint32_t typeMask = kAllStatsTypes);
+        // Returns the report which is serialized by StatsSnapshotWriter.
+        uint8_t*
+        GetStatsSnapshot(const RTCStatsReport* report, size_t* length, uint32_t typeMask = kAllStatsTypes);
         void DeleteStatsReport(const webrtc::RTCStatsReport* report);
 
+        // StatsSampler
+        void StartStatsSampler(PeerConnectionObject* obj, TimeDelta interval);
+        void StopStatsSampler(PeerConnectionObject* obj);
+        StatsSampleBuffer* GetStatsSampleBuffer() { return &m_statsSampleBuffer; }
+
         // DataChannel
         DataChannelInterface*
         CreateDataChannel(PeerConnectionObject* obj, const char* label, const DataChannelInit& options);
@@ -158,9 +150,12 @@ namespace webrtc
         std::unique_ptr<rtc::Thread> m_workerThread;
         std::unique_ptr<rtc::Thread> m_signalingThread;
         std::unique_ptr<TaskQueueFactory> m_taskQueueFactory;
+        const AudioConfig m_audioConfig;
         rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> m_peerConnectionFactory;
         rtc::scoped_refptr<DummyAudioDevice> m_audioDevice;
         std::vector<rtc::scoped_refptr<const webrtc::RTCStatsReport>> m_listStatsReport;
+        StatsSampleBuffer m_statsSampleBuffer;
+        std::map<const PeerConnectionObject*, std::unique_ptr<StatsSampler>> m_mapStatsSamplers;
         std::map<const PeerConnectionObject*, std::unique_ptr<PeerConnectionObject>> m_mapClients;
         std::map<const webrtc::MediaStreamInterface*, std::unique_ptr<MediaStreamObserver>> m_mapMediaStreamObserver;
         std::map<const DataChannelInterface*, std::unique_ptr<DataChannelObject>> m_mapDataChannels;
@@ -0,0 +1,127 @@
+#include "pch.h"
+
+#include "DataChannelMessageArena.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    DataChannelMessageArena::DataChannelMessageArena(size_t blockSize)
+        : blockSize_(blockSize)
+        , current_(nullptr)
+        , acquired_(0)
+    {
+        RTC_DCHECK_GT(blockSize, 0);
+    }
+
+    DataChannelMessageArena::~DataChannelMessageArena() = default;
+
+    bool DataChannelMessageArena::Append(const uint8_t* data, size_t size, bool binary)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (current_ == nullptr || current_->capacity - current_->used < size)
+        {
+            Block* previous = current_;
+            // The message which is larger than the block size has its own block.
+            current_ = AllocateBlock(std::max(size, blockSize_));
+            if (previous && previous->messages == 0)
+                RecycleBlock(previous);
+        }
+
+        const size_t offset = current_->used;
+        if (size > 0)
+            std::memcpy(current_->data.get() + offset, data, size);
+        current_->used += size;
+        current_->messages++;
+
+        const bool notify = entries_.size() == acquired_;
+        entries_.push_back({ current_, offset, size, binary });
+        return notify;
+    }
+
+    size_t DataChannelMessageArena::Acquire(DataChannelMessage* messages, size_t maxCount)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t count = std::min(maxCount, entries_.size() - acquired_);
+        for (size_t i = 0; i < count; i++)
+        {
+            const Entry& entry = entries_[acquired_ + i];
+            messages[i].data = entry.block->data.get() + entry.offset;
+            messages[i].size = static_cast<int32_t>(entry.size);
+            messages[i].binary = entry.binary;
+        }
+        acquired_ += count;
+        return count;
+    }
+
+    void DataChannelMessageArena::Release(size_t count)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        RTC_DCHECK_LE(count, acquired_);
+        count = std::min(count, acquired_);
+        for (size_t i = 0; i < count; i++)
+        {
+            Block* block = entries_.front().block;
+            entries_.pop_front();
+            if (--block->messages > 0)
+                continue;
+            if (block == current_)
+                // Nothing refers to the current block, so it is filled again from the start.
+                block->used = 0;
+            else
+                RecycleBlock(block);
+        }
+        acquired_ -= count;
+    }
+
+    size_t DataChannelMessageArena::Size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    size_t DataChannelMessageArena::BlockCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return blocks_.size();
+    }
+
+    DataChannelMessageArena::Block* DataChannelMessageArena::AllocateBlock(size_t size)
+    {
+        auto it = std::find_if(
+            freeBlocks_.begin(), freeBlocks_.end(), [size](const Block* block) { return block->capacity >= size; });
+        if (it != freeBlocks_.end())
+        {
+            Block* block = *it;
+            freeBlocks_.erase(it);
+            return block;
+        }
+
+        auto block = std::make_unique<Block>();
+        block->data = std::make_unique<uint8_t[]>(size);
+        block->capacity = size;
+        block->used = 0;
+        block->messages = 0;
+        blocks_.push_back(std::move(block));
+        return blocks_.back().get();
+    }
+
+    void DataChannelMessageArena::RecycleBlock(Block* block)
+    {
+        RTC_DCHECK_EQ(block->messages, 0);
+        block->used = 0;
+
+        // The oversized block for the large message is not kept.
+        if (block->capacity == blockSize_ && freeBlocks_.size() < kMaxFreeBlocks)
+        {
+            freeBlocks_.push_back(block);
+            return;
+        }
+        auto it = std::find_if(blocks_.begin(), blocks_.end(), [block](const std::unique_ptr<Block>& b) {
+            return b.get() == block;
+        });
+        RTC_DCHECK(it != blocks_.end());
+        blocks_.erase(it);
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace unity
+{
+namespace webrtc
+{
+    // The view of the message which is passed between Unity and the plugin. For the received message, |data| is valid
+    // until the message is released.
+    struct DataChannelMessage
+    {
+        const uint8_t* data;
+        int32_t size;
+        bool binary;
+    };
+
+    // Keeps the received messages in the pooled blocks, so that Unity reads them in place and releases them in
+    // bulk instead of allocating a managed array for each message.
+    // Append is called on the signaling thread, and Acquire and Release are called on the main thread of Unity.
+    class DataChannelMessageArena
+    {
+    public:
+        static constexpr size_t kDefaultBlockSize = 64 * 1024;
+        // The released blocks which are kept for reuse.
+        static constexpr size_t kMaxFreeBlocks = 4;
+
+        explicit DataChannelMessageArena(size_t blockSize = kDefaultBlockSize);
+        DataChannelMessageArena(const DataChannelMessageArena&) = delete;
+        DataChannelMessageArena& operator=(const DataChannelMessageArena&) = delete;
+        ~DataChannelMessageArena();
+
+        // Copies the message into the arena. Returns true when no message was waiting to be acquired, which means
+        // Unity should be notified.
+        bool Append(const uint8_t* data, size_t size, bool binary);
+
+        // Fills |messages| with up to |maxCount| messages which have not been acquired yet, in the received order.
+        // Returns the number of the filled messages.
+        size_t Acquire(DataChannelMessage* messages, size_t maxCount);
+
+        // Releases the |count| oldest acquired messages. Their data must not be accessed after this call.
+        void Release(size_t count);
+
+        // The number of the messages which are not released.
+        size_t Size() const;
+        // The number of the allocated blocks including the free ones.
+        size_t BlockCount() const;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<uint8_t[]> data;
+            size_t capacity;
+            size_t used;
+            // The number of the messages in this block which are not released.
+            size_t messages;
+        };
+
+        struct Entry
+        {
+            Block* block;
+            size_t offset;
+            size_t size;
+            bool binary;
+        };
+
+        Block* AllocateBlock(size_t size);
+        void RecycleBlock(Block* block);
+
+        const size_t blockSize_;
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<Block>> blocks_;
+        std::vector<Block*> freeBlocks_;
+        Block* current_;
+        std::deque<Entry> entries_;
+        // The number of the messages at the front of |entries_| which have been acquired.
+        size_t acquired_;
+    };
+} // end namespace webrtc
+} // end namespace unity
@@ -8,14 +8,22 @@ namespace webrtc
 {
 
     DataChannelObject::DataChannelObject(
-        rtc::scoped_refptr<webrtc::DataChannelInterface> channel, PeerConnectionObject& pc)
+        rtc::scoped_refptr<webrtc::DataChannelInterface> channel,
+        PeerConnectionObject& pc,
+        rtc::Thread* signalingThread)
         : dataChannel(channel)
+        , signalingThread_(signalingThread)
+        , safety_(PendingTaskSafetyFlag::CreateDetached())
     {
         dataChannel->RegisterObserver(this);
     }
     DataChannelObject::~DataChannelObject()
     {
         dataChannel->UnregisterObserver();
+        signalingThread_->BlockingCall([this]() {
+            safety_->SetNotAlive();
+            sendQueue_.clear();
+        });
 
         auto state = dataChannel->state();
         if (state == webrtc::DataChannelInterface::kOpen)
@@ -26,6 +34,138 @@ namespace webrtc
         onClose = nullptr;
         onOpen = nullptr;
         onMessage = nullptr;
+        onMessagesAvailable = nullptr;
+        onBufferedAmountLow = nullptr;
+    }
+
+    void DataChannelObject::EnableMessageArena(size_t blockSize, DelegateOnMessagesAvailable callback)
+    {
+        // OnMessage reads the arena on the signaling thread, so it is published there. Returning from the call
+        // publishes it to the caller as well.
+        signalingThread_->BlockingCall([&]() {
+            onMessagesAvailable = callback;
+            if (!messageArena)
+                messageArena = std::make_unique<DataChannelMessageArena>(blockSize);
+        });
+    }
+
+    size_t DataChannelObject::SendBatch(const DataChannelMessage* messages, size_t count)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            RTC_DCHECK_GE(messages[i].size, 0);
+            total += static_cast<size_t>(messages[i].size);
+        }
+
+        // The messages are the slices of the batch, so they share one allocation.
+        rtc::CopyOnWriteBuffer batch(total);
+        uint8_t* dest = batch.MutableData();
+        for (size_t i = 0; i < count; i++)
+        {
+            const size_t size = static_cast<size_t>(messages[i].size);
+            if (size > 0)
+                std::memcpy(dest, messages[i].data, size);
+            dest += size;
+        }
+
+        // The proxy of the data channel hops to the signaling thread on each call. Calling on the thread skips it.
+        return signalingThread_->BlockingCall([&]() {
+            size_t offset = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t size = static_cast<size_t>(messages[i].size);
+                if (!dataChannel->Send(DataBuffer(batch.Slice(offset, size), messages[i].binary)))
+                    return i;
+                offset += size;
+            }
+            return count;
+        });
+    }
+
+    void DataChannelObject::SendQueued(const uint8_t* data, size_t size, bool binary)
+    {
+        DataBuffer buffer(rtc::CopyOnWriteBuffer(data, size), binary);
+        queuedAmount_.fetch_add(size, std::memory_order_relaxed);
+        signalingThread_->PostTask(SafeTask(safety_, [this, buffer = std::move(buffer)]() mutable {
+            sendQueue_.push_back(std::move(buffer));
+            DrainSendQueue();
+        }));
+    }
+
+    void DataChannelObject::SetBufferedAmountThresholds(uint64_t high, uint64_t low)
+    {
+        RTC_DCHECK_LE(low, high);
+        highWatermark_.store(high, std::memory_order_relaxed);
+        lowWatermark_.store(std::min(low, high), std::memory_order_relaxed);
+        signalingThread_->PostTask(SafeTask(safety_, [this]() { DrainSendQueue(); }));
+    }
+
+    void DataChannelObject::DrainSendQueue()
+    {
+        RTC_DCHECK_RUN_ON(signalingThread_);
+
+        // The messages are held until the channel opens, and never sent after it starts closing.
+        const auto state = dataChannel->state();
+        if (state == webrtc::DataChannelInterface::kConnecting)
+            return;
+        if (state != webrtc::DataChannelInterface::kOpen)
+        {
+            DropSendQueue();
+            return;
+        }
+
+        const uint64_t high = highWatermark_.load(std::memory_order_relaxed);
+        uint64_t buffered = dataChannel->buffered_amount();
+        while (!sendQueue_.empty())
+        {
+            const DataBuffer& buffer = sendQueue_.front();
+            // Pass the message larger than the watermark when nothing is buffered, otherwise it is never sent.
+            if (buffered > 0 && buffered + buffer.size() > high)
+                break;
+
+            const uint64_t size = buffer.size();
+            if (!dataChannel->Send(buffer))
+            {
+                // The message is kept, and dropped when the channel starts closing.
+                break;
+            }
+            sendQueue_.pop_front();
+            queuedAmount_.fetch_sub(size, std::memory_order_relaxed);
+            buffered = dataChannel->buffered_amount();
+        }
+
+        const uint64_t total = buffered + queuedAmount_.load(std::memory_order_relaxed);
+        if (total > lowWatermark_.load(std::memory_order_relaxed))
+        {
+            aboveLowWatermark_ = true;
+        }
+        else if (aboveLowWatermark_)
+        {
+            aboveLowWatermark_ = false;
+            if (onBufferedAmountLow != nullptr)
+            {
+                onBufferedAmountLow(this->dataChannel.get());
+            }
+        }
+    }
+
+    void DataChannelObject::DropSendQueue()
+    {
+        RTC_DCHECK_RUN_ON(signalingThread_);
+
+        uint64_t dropped = 0;
+        for (const auto& queued : sendQueue_)
+            dropped += queued.size();
+        sendQueue_.clear();
+        queuedAmount_.fetch_sub(dropped, std::memory_order_relaxed);
+        aboveLowWatermark_ = false;
+    }
+
+    void DataChannelObject::OnBufferedAmountChange(uint64_t sent_data_size)
+    {
+        // The observer may be called while the channel is sending, so the queue is drained on the next task.
+        signalingThread_->PostTask(SafeTask(safety_, [this]() { DrainSendQueue(); }));
     }
 
     void DataChannelObject::OnStateChange()
@@ -34,24 +174,39 @@ namespace webrtc
         switch (state)
         {
         case webrtc::DataChannelInterface::kOpen:
+            // Send the messages which have been queued before the channel opens.
+            signalingThread_->PostTask(SafeTask(safety_, [this]() { DrainSendQueue(); }));
             if (onOpen != nullptr)
             {
                 onOpen(this->dataChannel.get());
             }
             break;
         case webrtc::DataChannelInterface::kClosed:
+            // The queued messages are dropped. The producer knows it by onClose.
+            signalingThread_->PostTask(SafeTask(safety_, [this]() { DrainSendQueue(); }));
             if (onClose != nullptr)
             {
                 onClose(this->dataChannel.get());
             }
             break;
-        case webrtc::DataChannelInterface::kConnecting:
         case webrtc::DataChannelInterface::kClosing:
+            signalingThread_->PostTask(SafeTask(safety_, [this]() { DrainSendQueue(); }));
+            break;
+        case webrtc::DataChannelInterface::kConnecting:
             break;
         }
     }
     void DataChannelObject::OnMessage(const webrtc::DataBuffer& buffer)
     {
+        if (messageArena)
+        {
+            bool notify = messageArena->Append(buffer.data.data(), buffer.data.size(), buffer.binary);
+            if (notify && onMessagesAvailable != nullptr)
+            {
+                onMessagesAvailable(this->dataChannel.get());
+            }
+            return;
+        }
         if (onMessage != nullptr)
         {
             size_t size = buffer.data.size();
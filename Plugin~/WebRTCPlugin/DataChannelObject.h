@@ -1,6 +1,12 @@
 #pragma once
 
+#include <deque>
+
 #include <api/data_channel_interface.h>
+#include <api/task_queue/pending_task_safety_flag.h>
+#include <rtc_base/thread.h>
+
+#include "DataChannelMessageArena.h"
 
 namespace unity
 {
@@ -14,27 +20,77 @@ namespace webrtc
     using DelegateOnMessage = void (*)(DataChannelInterface*, const uint8_t*, int32_t);
     using DelegateOnOpen = void (*)(DataChannelInterface*);
     using DelegateOnClose = void (*)(DataChannelInterface*);
+    using DelegateOnMessagesAvailable = void (*)(DataChannelInterface*);
+    using DelegateOnBufferedAmountLow = void (*)(DataChannelInterface*);
 
     class DataChannelObject : public DataChannelObserver
     {
     public:
-        DataChannelObject(rtc::scoped_refptr<DataChannelInterface> channel, PeerConnectionObject& pc);
+        static constexpr uint64_t kDefaultHighWatermark = 1024 * 1024;
+        static constexpr uint64_t kDefaultLowWatermark = 256 * 1024;
+
+        DataChannelObject(
+            rtc::scoped_refptr<DataChannelInterface> channel, PeerConnectionObject& pc, rtc::Thread* signalingThread);
         ~DataChannelObject() override;
 
         void Close() { dataChannel->Close(); }
+
+        // Copies the messages into one buffer and sends them on the signaling thread in one hop. Returns the number
+        // of the sent messages, which is smaller than |count| when the channel refuses a message.
+        size_t SendBatch(const DataChannelMessage* messages, size_t count);
+
         void RegisterOnMessage(DelegateOnMessage callback) { onMessage = callback; }
         void RegisterOnOpen(DelegateOnOpen callback) { onOpen = callback; }
         void RegisterOnClose(DelegateOnClose callback) { onClose = callback; }
+        void RegisterOnBufferedAmountLow(DelegateOnBufferedAmountLow callback) { onBufferedAmountLow = callback; }
+
+        // Queues the message without blocking. The queued messages are held until the channel opens, then passed to
+        // the channel while its buffered amount is below |high|. |onBufferedAmountLow| is called when the sum of the
+        // buffered and the queued amount falls to |low| or below. The queue is dropped when the channel closes.
+        void SendQueued(const uint8_t* data, size_t size, bool binary);
+        void SetBufferedAmountThresholds(uint64_t high, uint64_t low);
+        // The amount of the messages which are queued by SendQueued and not passed to the channel yet.
+        uint64_t GetQueuedAmount() const { return queuedAmount_.load(std::memory_order_relaxed); }
+
+        // Keeps the received messages in the arena instead of passing them to |onMessage|. |callback| is called when
+        // a message arrives while no message is waiting to be acquired. Blocks until the signaling thread has
+        // installed the arena.
+        void EnableMessageArena(size_t blockSize, DelegateOnMessagesAvailable callback);
+        // Returns nullptr when the arena is not enabled.
+        DataChannelMessageArena* GetMessageArena() const { return messageArena.get(); }
+
         // werbrtc::DataChannelObserver
         // The data channel state have changed.
         void OnStateChange() override;
         //  A data buffer was successfully received.
         void OnMessage(const webrtc::DataBuffer& buffer) override;
+        // The buffered amount of the data channel decreased.
+        void OnBufferedAmountChange(uint64_t sent_data_size) override;
 
         DelegateOnMessage onMessage = nullptr;
         DelegateOnOpen onOpen = nullptr;
         DelegateOnClose onClose = nullptr;
+        DelegateOnMessagesAvailable onMessagesAvailable = nullptr;
+        DelegateOnBufferedAmountLow onBufferedAmountLow = nullptr;
+        std::unique_ptr<DataChannelMessageArena> messageArena;
         rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel;
+
+    private:
+        // Called on the signaling thread.
+        void DrainSendQueue();
+        void DropSendQueue();
+
+        rtc::Thread* const signalingThread_;
+        // Drops the tasks which are posted to the signaling thread after this object is destroyed.
+        rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
+
+        // Accessed only on the signaling thread.
+        std::deque<DataBuffer> sendQueue_;
+        bool aboveLowWatermark_ = false;
+
+        std::atomic<uint64_t> queuedAmount_ { 0 };
+        std::atomic<uint64_t> highWatermark_ { kDefaultHighWatermark };
+        std::atomic<uint64_t> lowWatermark_ { kDefaultLowWatermark };
     };
 
 } // end namespace webrtc
@@ -0,0 +1,64 @@
+#include "pch.h"
+
+#include <rtc_base/ref_counted_object.h>
+
+#include "DemuxAudioMixer.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    rtc::scoped_refptr<DemuxAudioMixer> DemuxAudioMixer::Create(int sampleRate)
+    {
+        return rtc::make_ref_counted<DemuxAudioMixer>(sampleRate);
+    }
+
+    DemuxAudioMixer::DemuxAudioMixer(int sampleRate)
+        : sampleRate_(sampleRate)
+    {
+    }
+
+    DemuxAudioMixer::~DemuxAudioMixer() { }
+
+    bool DemuxAudioMixer::AddSource(Source* source)
+    {
+        RTC_DCHECK(source);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::find(sources_.begin(), sources_.end(), source) != sources_.end())
+            return false;
+        sources_.push_back(source);
+        return true;
+    }
+
+    void DemuxAudioMixer::RemoveSource(Source* source)
+    {
+        RTC_DCHECK(source);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find(sources_.begin(), sources_.end(), source);
+        if (it != sources_.end())
+            sources_.erase(it);
+    }
+
+    void DemuxAudioMixer::Mix(size_t number_of_channels, AudioFrame* audio_frame_for_mixing)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto source : sources_)
+            {
+                // Request the rate which the stream is decoded at, so that the stream is not resampled.
+                source->GetAudioFrameWithInfo(source->PreferredSampleRate(), &frame_);
+            }
+        }
+
+        // The muted frame of the rate of the audio device, so that AudioTransport doesn't resample it either.
+        audio_frame_for_mixing->UpdateFrame(
+            0,
+            nullptr,
+            static_cast<size_t>(sampleRate_ / 100),
+            sampleRate_,
+            AudioFrame::kNormalSpeech,
+            AudioFrame::kVadUnknown,
+            number_of_channels);
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <api/audio/audio_frame.h>
+#include <api/audio/audio_mixer.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // The audio mixer which only pulls each remote audio stream. Pulling a stream decodes it and passes the audio to
+    // the sinks of the track, which is all this plugin needs. The streams are neither mixed nor resampled, and the
+    // output is always silent because DummyAudioDevice discards it.
+    class DemuxAudioMixer : public AudioMixer
+    {
+    public:
+        static rtc::scoped_refptr<DemuxAudioMixer> Create(int sampleRate);
+
+        // AudioMixer
+        bool AddSource(Source* source) override;
+        void RemoveSource(Source* source) override;
+        void Mix(size_t number_of_channels, AudioFrame* audio_frame_for_mixing) override;
+
+    protected:
+        explicit DemuxAudioMixer(int sampleRate);
+        ~DemuxAudioMixer() override;
+
+    private:
+        const int sampleRate_;
+        std::mutex mutex_;
+        std::vector<Source*> sources_;
+        // The decoded frame which is not used after passing to the sinks.
+        AudioFrame frame_;
+    };
+} // end namespace webrtc
+} // end namespace unity
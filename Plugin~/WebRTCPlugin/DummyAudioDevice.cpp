@@ -1,5 +1,6 @@
 #include "pch.h"
 
+#include <rtc_base/time_utils.h>
 #include <system_wrappers/include/sleep.h>
 
 #include "DummyAudioDevice.h"
@@ -9,14 +10,25 @@ namespace unity
 {
 namespace webrtc
 {
-    DummyAudioDevice::DummyAudioDevice(TaskQueueFactory* taskQueueFactory)
-        : audio_data(kChannels * kSamplesPerFrame)
+    DummyAudioDevice::DummyAudioDevice(TaskQueueFactory* taskQueueFactory, const AudioConfig& config)
+        : kChannels(static_cast<size_t>(config.channels))
+        , kSamplingRate(config.sampleRate)
+        , kSamplesPerFrame(static_cast<size_t>(kSamplingRate * kFrameLengthMs / 1000))
+        , audio_data(kChannels * kSamplesPerFrame)
+        , externalClock_(config.pullOnUnityAudioThread)
         , tackQueueFactory_(taskQueueFactory)
     {
     }
 
     int32_t DummyAudioDevice::Init()
     {
+        if (externalClock_)
+        {
+            // The audio thread of Unity pulls the audio, so the timer thread is not needed.
+            initialized_ = true;
+            return 0;
+        }
+
         taskQueue_ = std::make_unique<rtc::TaskQueue>(
             tackQueueFactory_->CreateTaskQueue("AudioDevice", TaskQueueFactory::Priority::NORMAL));
         task_ = RepeatingTaskHandle::Start(taskQueue_->Get(), [this]() {
@@ -34,7 +46,8 @@ namespace webrtc
 
         initialized_ = false;
 
-        taskQueue_->PostTask([this] { task_.Stop(); });
+        if (taskQueue_)
+            taskQueue_->PostTask([this] { task_.Stop(); });
 
         StopRecording();
         StopPlayout();
@@ -42,6 +55,22 @@ namespace webrtc
         return 0;
     }
 
+    void DummyAudioDevice::PullUntil(int64_t timeUs)
+    {
+        RTC_DCHECK(externalClock_);
+
+        // The sinks may request on the different threads of Unity at the same time.
+        std::lock_guard<std::mutex> lock(pullMutex_);
+        const int64_t frameLengthUs = kFrameLengthMs * rtc::kNumMicrosecsPerMillisec;
+        int64_t pulledTimeUs = pulledTimeUs_.load(std::memory_order_relaxed);
+        for (int32_t i = 0; i < kMaxPullFrames && pulledTimeUs < timeUs; i++)
+        {
+            ProcessAudio();
+            pulledTimeUs += frameLengthUs;
+        }
+        pulledTimeUs_.store(std::max(pulledTimeUs, timeUs - frameLengthUs), std::memory_order_release);
+    }
+
     void DummyAudioDevice::ProcessAudio()
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -57,7 +86,7 @@ namespace webrtc
             // audio data here is not used.
             // The original function of the method is getting final audio data that resampling
             // and mixing multiple audio stream. But we want each audio streams, not final
-            // result.
+            // result, so DemuxAudioMixer only pulls each stream and skips mixing them.
             audio_transport_->PullRenderData(
                 kBytesPerSample * 8, kSamplingRate, kChannels, kSamplesPerFrame, data, &elapsed_time_ms, &ntp_time_ms);
         }
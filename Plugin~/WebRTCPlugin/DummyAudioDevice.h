@@ -8,6 +8,8 @@
 #include <rtc_base/task_queue.h>
 #include <rtc_base/task_utils/repeating_task.h>
 
+#include "AudioConfig.h"
+#include "AudioTrackSinkAdapter.h"
 #include "WebRTCPlugin.h"
 
 namespace unity
@@ -18,10 +20,12 @@ namespace webrtc
 
     class UnityAudioTrackSource;
 
-    class DummyAudioDevice : public webrtc::AudioDeviceModule
+    class DummyAudioDevice : public webrtc::AudioDeviceModule, public ExternalAudioClock
     {
     public:
-        DummyAudioDevice(TaskQueueFactory* factory);
+        // When |config.pullOnUnityAudioThread| is true, the audio is pulled by PullUntil instead of the timer of
+        // this device.
+        DummyAudioDevice(TaskQueueFactory* factory, const AudioConfig& config = AudioConfig());
         ~DummyAudioDevice() override { Terminate(); }
 
         // webrtc::AudioDeviceModule
@@ -145,9 +149,17 @@ namespace webrtc
         virtual int32_t MicrophoneMute(bool* enabled) const override { return 0; }
 
         // Stereo support
-        virtual int32_t StereoPlayoutIsAvailable(bool* available) const override { return 0; }
+        virtual int32_t StereoPlayoutIsAvailable(bool* available) const override
+        {
+            *available = kChannels == 2;
+            return 0;
+        }
         virtual int32_t SetStereoPlayout(bool enable) override { return 0; }
-        virtual int32_t StereoPlayout(bool* enabled) const override { return 0; }
+        virtual int32_t StereoPlayout(bool* enabled) const override
+        {
+            *enabled = kChannels == 2;
+            return 0;
+        }
         virtual int32_t StereoRecordingIsAvailable(bool* available) const override
         {
             *available = true;
@@ -177,16 +189,28 @@ namespace webrtc
         virtual int GetRecordAudioParameters(webrtc::AudioParameters* params) const override { return 0; }
 #endif
 
+        int32_t SamplingRate() const { return kSamplingRate; }
+
+        // ExternalAudioClock
+        int64_t PulledTimeUs() const override { return pulledTimeUs_.load(std::memory_order_acquire); }
+        void PullUntil(int64_t timeUs) override;
+
     private:
         void ProcessAudio();
         bool PlayoutThreadProcess();
 
         const int32_t kFrameLengthMs = 10;
         const int32_t kBytesPerSample = 2;
-        const size_t kChannels = 2;
-        const int32_t kSamplingRate = 48000;
-        const size_t kSamplesPerFrame = static_cast<size_t>(kSamplingRate * kFrameLengthMs / 1000);
+        const size_t kChannels;
+        const int32_t kSamplingRate;
+        const size_t kSamplesPerFrame;
+        // The number of the frames which can be pulled at once. The backlog over this is dropped, for example after
+        // the application is paused.
+        const int32_t kMaxPullFrames = 10;
         std::vector<int16_t> audio_data;
+        const bool externalClock_;
+        std::mutex pullMutex_;
+        std::atomic<int64_t> pulledTimeUs_ { 0 };
         std::unique_ptr<rtc::TaskQueue> taskQueue_;
         RepeatingTaskHandle task_;
         std::atomic<bool> initialized_ { false };
@@ -21,11 +21,11 @@ namespace webrtc
         , texture_(nullptr)
         , textureCpuRead_(nullptr)
         , handle_(nullptr)
+        , cpuReadRequested_(false)
     {
         uint32_t width = static_cast<uint32_t>(size.width());
         uint32_t height = static_cast<uint32_t>(size.height());
         texture_.reset(device_->CreateDefaultTextureV(width, height, format));
-        textureCpuRead_.reset(device_->CreateCPUReadTextureV(width, height, format));
 
 // todo(kazuki): need to refactor
 #if CUDA_PLATFORM
@@ -53,7 +53,7 @@ namespace webrtc
             RTC_LOG(LS_INFO) << "ResetSync failed.";
             return false;
         }
-        if (!device_->ResetSync(textureCpuRead_.get()))
+        if (textureCpuRead_ && !device_->ResetSync(textureCpuRead_.get()))
         {
             RTC_LOG(LS_INFO) << "ResetSync failed.";
             return false;
@@ -64,20 +64,36 @@ namespace webrtc
     bool GpuMemoryBufferFromUnity::CopyBuffer(NativeTexPtr ptr)
     {
         // One texture cannot map CUDA memory and CPU memory simultaneously.
-        // Believe there is still room for improvement.
+        // The texture for CPU readback is copied only when the consumer needs it.
         if (!device_->CopyResourceFromNativeV(texture_.get(), ptr))
             return false;
-        if (!device_->CopyResourceFromNativeV(textureCpuRead_.get(), ptr))
+        if (textureCpuRead_ && !device_->CopyResourceFromNativeV(textureCpuRead_.get(), ptr))
             return false;
         return true;
     }
 
+    void GpuMemoryBufferFromUnity::AttachCpuReadTexture(std::unique_ptr<ITexture2D> texture)
+    {
+        RTC_DCHECK(!textureCpuRead_);
+        textureCpuRead_ = std::move(texture);
+    }
+
+    std::unique_ptr<ITexture2D> GpuMemoryBufferFromUnity::DetachCpuReadTexture() { return std::move(textureCpuRead_); }
+
     UnityRenderingExtTextureFormat GpuMemoryBufferFromUnity::GetFormat() const { return format_; }
 
     Size GpuMemoryBufferFromUnity::GetSize() const { return size_; }
 
-    rtc::scoped_refptr<I420BufferInterface> GpuMemoryBufferFromUnity::ToI420()
+    ITexture2D* GpuMemoryBufferFromUnity::WaitCpuReadTexture()
     {
+        // Notify the owner that the consumer of this buffer needs the texture for CPU readback.
+        cpuReadRequested_.store(true, std::memory_order_release);
+        if (!textureCpuRead_)
+        {
+            RTC_LOG(LS_INFO) << "The texture for CPU readback is not attached.";
+            return nullptr;
+        }
+
         using namespace std::chrono_literals;
         const std::chrono::nanoseconds timeout(30ms); // 30ms
         if (!device_->WaitSync(textureCpuRead_.get(), timeout.count()))
@@ -85,7 +101,23 @@ namespace webrtc
             RTC_LOG(LS_INFO) << "WaitSync failed.";
             return nullptr;
         }
-        return device_->ConvertRGBToI420(textureCpuRead_.get());
+        return textureCpuRead_.get();
+    }
+
+    rtc::scoped_refptr<I420BufferInterface> GpuMemoryBufferFromUnity::ToI420()
+    {
+        ITexture2D* texture = WaitCpuReadTexture();
+        if (!texture)
+            return nullptr;
+        return device_->ConvertRGBToI420(texture);
+    }
+
+    rtc::scoped_refptr<NV12BufferInterface> GpuMemoryBufferFromUnity::ToNV12()
+    {
+        ITexture2D* texture = WaitCpuReadTexture();
+        if (!texture)
+            return nullptr;
+        return device_->ConvertRGBToNV12(texture);
     }
 
     const GpuMemoryBufferHandle* GpuMemoryBufferFromUnity::handle() const
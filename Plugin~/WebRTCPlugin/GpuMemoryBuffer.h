@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <shared_mutex>
 
 #include <common_video/include/video_frame_buffer.h>
@@ -35,6 +36,7 @@ namespace webrtc
         virtual Size GetSize() const = 0;
         virtual UnityRenderingExtTextureFormat GetFormat() const = 0;
         virtual rtc::scoped_refptr<I420BufferInterface> ToI420() = 0;
+        virtual rtc::scoped_refptr<NV12BufferInterface> ToNV12() = 0;
 
         virtual const GpuMemoryBufferHandle* handle() const = 0;
 
@@ -51,21 +53,38 @@ namespace webrtc
 
         bool ResetSync();
         bool CopyBuffer(NativeTexPtr ptr);
+
+        // The texture for CPU readback is only needed by software encoders, so it is attached by the owner of the
+        // buffer on demand. CopyBuffer copies the source into it only when attached, otherwise ToI420 and ToNV12
+        // return nullptr. The copy cannot be issued off the render thread on every backend, so the frame is dropped.
+        void AttachCpuReadTexture(std::unique_ptr<ITexture2D> texture);
+        std::unique_ptr<ITexture2D> DetachCpuReadTexture();
+        bool HasCpuReadTexture() const { return textureCpuRead_ != nullptr; }
+
+        // Returns true if ToI420 or ToNV12 method has been called since the last reset.
+        bool IsCpuReadRequested() const { return cpuReadRequested_.load(std::memory_order_acquire); }
+        void ResetCpuReadRequested() { cpuReadRequested_.store(false, std::memory_order_relaxed); }
+
         UnityRenderingExtTextureFormat GetFormat() const override;
         Size GetSize() const override;
         rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+        rtc::scoped_refptr<NV12BufferInterface> ToNV12() override;
         const GpuMemoryBufferHandle* handle() const override;
 
     protected:
         ~GpuMemoryBufferFromUnity() override;
 
     private:
+        // Returns the texture for CPU readback after waiting for the copy, or nullptr if it is not ready.
+        ITexture2D* WaitCpuReadTexture();
+
         IGraphicsDevice* device_;
         UnityRenderingExtTextureFormat format_;
         Size size_;
         std::unique_ptr<ITexture2D> texture_;
         std::unique_ptr<ITexture2D> textureCpuRead_;
         std::unique_ptr<GpuMemoryBufferHandle> handle_;
+        std::atomic<bool> cpuReadRequested_;
     };
 }
 }
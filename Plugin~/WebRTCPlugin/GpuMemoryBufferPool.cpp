@@ -10,94 +10,437 @@ namespace unity
 {
 namespace webrtc
 {
-    GpuMemoryBufferPool::GpuMemoryBufferPool(IGraphicsDevice* device, Clock* clock)
+    // The number of the buffers which a source can hold is decided from the ratio of the encoder latency and the
+    // capture interval.
+    static const size_t kMinBuffersPerSource = 2;
+    static const size_t kMaxBuffersPerSource = 8;
+    static const size_t kBytesPerPixel = 4;
+    // The texture for CPU readback is detached from the buffers of the source when no consumer reads it during this
+    // period. Hardware encoders never read it.
+    static constexpr TimeDelta kCpuReadIdleLimit = TimeDelta::Seconds(3);
+
+    void GpuMemoryBufferPool::Bucket::PushReturned(FrameResources* resources)
+    {
+        // Multiple producers push, the render thread takes all elements at once.
+        FrameResources* head = returned_.load(std::memory_order_relaxed);
+        do
+        {
+            resources->next_ = head;
+        } while (!returned_.compare_exchange_weak(
+            head, resources, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void GpuMemoryBufferPool::Bucket::PushFree(FrameResources* resources)
+    {
+        resources->next_ = free_;
+        free_ = resources;
+    }
+
+    GpuMemoryBufferPool::FrameResources* GpuMemoryBufferPool::Bucket::PopFree()
+    {
+        if (!free_)
+            free_ = returned_.exchange(nullptr, std::memory_order_acquire);
+        FrameResources* resources = free_;
+        if (resources)
+        {
+            free_ = resources->next_;
+            resources->next_ = nullptr;
+        }
+        return resources;
+    }
+
+    GpuMemoryBufferPool::SourceBudget::SourceBudget(Timestamp timestamp)
+        : inUseCount(0)
+        , inUseBytes(0)
+        , latencySumUs(0)
+        , latencyCount(0)
+        , lastCpuReadUs(timestamp.us())
+        , quota(bufferedFrameNum)
+        , encodeLatency(TimeDelta::Zero())
+        , captureInterval(TimeDelta::Zero())
+        , lastAcquireTime(timestamp)
+        , throttledCount(0)
+        , lastThrottleReason(ThrottleReason::kNone)
+    {
+    }
+
+    void GpuMemoryBufferPool::SourceBudget::UpdateQuota(Timestamp timestamp)
+    {
+        // The samples are folded into moving averages on the render thread.
+        int64_t count = latencyCount.exchange(0, std::memory_order_relaxed);
+        int64_t sumUs = latencySumUs.exchange(0, std::memory_order_relaxed);
+        if (count > 0)
+        {
+            TimeDelta sample = TimeDelta::Micros(sumUs / count);
+            encodeLatency = encodeLatency.IsZero() ? sample : (encodeLatency * 7 + sample) / 8;
+        }
+        TimeDelta interval = timestamp - lastAcquireTime;
+        if (interval > TimeDelta::Zero())
+        {
+            captureInterval = captureInterval.IsZero() ? interval : (captureInterval * 7 + interval) / 8;
+        }
+        lastAcquireTime = timestamp;
+
+        if (encodeLatency.IsZero() || captureInterval.IsZero())
+            return;
+
+        // One buffer for each frame being encoded, and one for capturing the next frame.
+        int64_t framesInFlight = (encodeLatency.us() + captureInterval.us() - 1) / captureInterval.us();
+        quota = std::clamp(static_cast<size_t>(framesInFlight) + 1, kMinBuffersPerSource, kMaxBuffersPerSource);
+    }
+
+    bool GpuMemoryBufferPool::SourceBudget::NeedsCpuRead(Timestamp timestamp) const
+    {
+        return timestamp.us() - lastCpuReadUs.load(std::memory_order_relaxed) < kCpuReadIdleLimit.us();
+    }
+
+    GpuMemoryBufferPool::GpuMemoryBufferPool(IGraphicsDevice* device, Clock* clock, size_t maxBytes)
         : device_(device)
+        , bufferCount_(0)
+        , allocatedBytes_(0)
+        , freeListPopCount_(0)
+        , maxBytes_(maxBytes)
         , clock_(clock)
     {
     }
 
     GpuMemoryBufferPool::~GpuMemoryBufferPool() { }
 
+    size_t GpuMemoryBufferPool::EstimateTextureBytes(const Size& size, UnityRenderingExtTextureFormat format)
+    {
+        return static_cast<size_t>(size.width()) * static_cast<size_t>(size.height()) * kBytesPerPixel;
+    }
+
     rtc::scoped_refptr<VideoFrame> GpuMemoryBufferPool::CreateFrame(
-        NativeTexPtr ptr, const Size& size, UnityRenderingExtTextureFormat format, Timestamp timestamp)
+        NativeTexPtr ptr,
+        const Size& size,
+        UnityRenderingExtTextureFormat format,
+        Timestamp timestamp,
+        const void* source,
+        ThrottleReason* reason)
     {
-        auto buffer = GetOrCreateFrameResources(ptr, size, format);
+        const Timestamp now = clock_->CurrentTime();
+        SourceBudget* budget = GetOrCreateSourceBudget(source, now);
+        budget->UpdateQuota(now);
+
+        const bool cpuRead = budget->NeedsCpuRead(now);
+        const size_t textureBytes = EstimateTextureBytes(size, format);
+        FrameResources* resources = nullptr;
+        Bucket* bucket = nullptr;
+        ThrottleReason result = CheckBudget(budget, cpuRead ? textureBytes * 2 : textureBytes);
+        if (result == ThrottleReason::kNone)
+        {
+            bucket = GetOrCreateBucket(size, format);
+            resources = GetOrCreateFrameResources(bucket, ptr, size, format, cpuRead, &result);
+        }
+        if (result != ThrottleReason::kNone)
+        {
+            budget->throttledCount++;
+            budget->lastThrottleReason = result;
+            RTC_LOG(LS_VERBOSE) << "The frame is throttled. source:" << source
+                                << " reason:" << static_cast<int>(result);
+        }
+        if (reason)
+            *reason = result;
+        if (!resources)
+            return nullptr;
+
+        budget->inUseCount.fetch_add(1, std::memory_order_relaxed);
+        budget->inUseBytes.fetch_add(resources->inUseBytes_, std::memory_order_relaxed);
+
         VideoFrame::ReturnBufferToPoolCallback callback =
-            std::bind(&GpuMemoryBufferPool::OnReturnBuffer, this, std::placeholders::_1);
+            [this, bucket, budget, resources](rtc::scoped_refptr<GpuMemoryBufferInterface>) {
+                OnReturnBuffer(bucket, budget, resources);
+            };
 
         return VideoFrame::WrapExternalGpuMemoryBuffer(
-            size, buffer, callback, webrtc::TimeDelta::Micros(timestamp.us()));
+            size, resources->buffer_, callback, webrtc::TimeDelta::Micros(timestamp.us()));
+    }
+
+    absl::optional<GpuMemoryBufferPool::SourceStats> GpuMemoryBufferPool::GetSourceStats(const void* source) const
+    {
+        auto it = sources_.find(source);
+        if (it == sources_.end())
+            return absl::nullopt;
+        const SourceBudget* budget = it->second.get();
+        return SourceStats { budget->inUseCount.load(std::memory_order_relaxed),
+                             budget->inUseBytes.load(std::memory_order_relaxed),
+                             budget->quota,
+                             budget->encodeLatency,
+                             budget->captureInterval,
+                             budget->throttledCount,
+                             budget->lastThrottleReason,
+                             budget->NeedsCpuRead(clock_->CurrentTime()) };
+    }
+
+    GpuMemoryBufferPool::Bucket*
+    GpuMemoryBufferPool::GetOrCreateBucket(const Size& size, UnityRenderingExtTextureFormat format)
+    {
+        std::unique_ptr<Bucket>& bucket = buckets_[BucketKey { size, format }];
+        if (!bucket)
+            bucket = std::make_unique<Bucket>();
+        return bucket.get();
     }
 
-    rtc::scoped_refptr<GpuMemoryBufferInterface> GpuMemoryBufferPool::GetOrCreateFrameResources(
-        NativeTexPtr ptr, const Size& size, UnityRenderingExtTextureFormat format)
+    GpuMemoryBufferPool::SourceBudget*
+    GpuMemoryBufferPool::GetOrCreateSourceBudget(const void* source, Timestamp timestamp)
     {
-        for (auto it = resourcesPool_.begin(); it != resourcesPool_.end(); ++it)
+        std::unique_ptr<SourceBudget>& budget = sources_[source];
+        if (!budget)
+            budget = std::make_unique<SourceBudget>(timestamp);
+        return budget.get();
+    }
+
+    GpuMemoryBufferPool::ThrottleReason GpuMemoryBufferPool::CheckBudget(const SourceBudget* budget, size_t bytes) const
+    {
+        size_t inUseCount = budget->inUseCount.load(std::memory_order_relaxed);
+        if (inUseCount >= budget->quota)
+            return ThrottleReason::kSourceQuotaExceeded;
+
+        // A source can always hold one buffer regardless of its share, otherwise a large frame never be sent.
+        size_t share = maxBytes_ / std::max<size_t>(sources_.size(), 1);
+        if (inUseCount > 0 && budget->inUseBytes.load(std::memory_order_relaxed) + bytes > share)
+            return ThrottleReason::kSourceByteShareExceeded;
+        return ThrottleReason::kNone;
+    }
+
+    GpuMemoryBufferPool::FrameResources* GpuMemoryBufferPool::GetOrCreateFrameResources(
+        Bucket* bucket,
+        NativeTexPtr ptr,
+        const Size& size,
+        UnityRenderingExtTextureFormat format,
+        bool cpuRead,
+        ThrottleReason* reason)
+    {
+        // Buffers which are not ready to reuse are kept aside and pushed back to the free-list.
+        FrameResources* pending = nullptr;
+        FrameResources* resources = nullptr;
+        while ((resources = bucket->PopFree()) != nullptr)
         {
-            FrameResources* resources = it->get();
-            if (!resources->IsUsed() && AreFrameResourcesCompatible(resources, size, format))
+            freeListPopCount_++;
+            GpuMemoryBufferFromUnity* buffer = static_cast<GpuMemoryBufferFromUnity*>(resources->buffer_.get());
+            if (!buffer->ResetSync())
+            {
+                RTC_LOG(LS_INFO) << "It has not signaled yet";
+            }
+            else if (!PrepareCpuReadTexture(bucket, buffer, cpuRead))
+            {
+                *reason = ThrottleReason::kByteBudgetExceeded;
+            }
+            else if (!buffer->CopyBuffer(ptr))
+            {
+                RTC_LOG(LS_INFO) << "Copy buffer is failed.";
+            }
+            else
             {
-                GpuMemoryBufferFromUnity* buffer = static_cast<GpuMemoryBufferFromUnity*>(resources->buffer_.get());
-                if (!buffer->ResetSync())
-                {
-                    RTC_LOG(LS_INFO) << "It has not signaled yet";
-                    continue;
-                }
-                if (!buffer->CopyBuffer(ptr))
-                {
-                    RTC_LOG(LS_INFO) << "Copy buffer is failed.";
-                    continue;
-                }
-                resources->MarkUsed(clock_->CurrentTime());
-                return resources->buffer_;
+                break;
             }
+            resources->next_ = pending;
+            pending = resources;
         }
+        while (pending)
+        {
+            FrameResources* next = pending->next_;
+            bucket->PushFree(pending);
+            pending = next;
+        }
+        if (resources)
+        {
+            *reason = ThrottleReason::kNone;
+            MarkUsed(resources);
+            return resources;
+        }
+        if (*reason != ThrottleReason::kNone)
+            return nullptr;
+
+        const size_t bytes = EstimateTextureBytes(size, format);
+        if (!Reserve(bytes, bucket))
+        {
+            *reason = ThrottleReason::kByteBudgetExceeded;
+            return nullptr;
+        }
+
         rtc::scoped_refptr<GpuMemoryBufferFromUnity> buffer =
             rtc::make_ref_counted<GpuMemoryBufferFromUnity>(device_, size, format);
+        bucket->resources_.push_back(std::make_unique<FrameResources>(buffer, bytes));
+        bufferCount_++;
+        allocatedBytes_ += bytes;
+        resources = bucket->resources_.back().get();
+
+        if (!PrepareCpuReadTexture(bucket, buffer.get(), cpuRead))
+        {
+            *reason = ThrottleReason::kByteBudgetExceeded;
+            bucket->PushFree(resources);
+            return nullptr;
+        }
         if (!buffer->CopyBuffer(ptr))
         {
             RTC_LOG(LS_INFO) << "Copy buffer is failed.";
+            bucket->PushFree(resources);
             return nullptr;
         }
-        std::unique_ptr<FrameResources> resources = std::make_unique<FrameResources>(buffer);
+        MarkUsed(resources);
+        return resources;
+    }
+
+    bool GpuMemoryBufferPool::PrepareCpuReadTexture(Bucket* bucket, GpuMemoryBufferFromUnity* buffer, bool cpuRead)
+    {
+        // The texture for CPU readback is moved between the buffers of the bucket, so the buffers for hardware
+        // encoders never hold it.
+        const Size size = buffer->GetSize();
+        const size_t bytes = EstimateTextureBytes(size, buffer->GetFormat());
+        if (!cpuRead)
+        {
+            if (buffer->HasCpuReadTexture())
+                bucket->cpuReadTextures_.push_back({ buffer->DetachCpuReadTexture(), bytes, clock_->CurrentTime() });
+            return true;
+        }
+        if (buffer->HasCpuReadTexture())
+            return true;
+        if (!bucket->cpuReadTextures_.empty())
+        {
+            buffer->AttachCpuReadTexture(std::move(bucket->cpuReadTextures_.back().texture));
+            bucket->cpuReadTextures_.pop_back();
+            return true;
+        }
+
+        if (!Reserve(bytes, bucket))
+            return false;
+        std::unique_ptr<ITexture2D> texture(device_->CreateCPUReadTextureV(
+            static_cast<uint32_t>(size.width()), static_cast<uint32_t>(size.height()), buffer->GetFormat()));
+        if (!texture)
+            return false;
+        allocatedBytes_ += bytes;
+        buffer->AttachCpuReadTexture(std::move(texture));
+        return true;
+    }
+
+    void GpuMemoryBufferPool::MarkUsed(FrameResources* resources)
+    {
+        GpuMemoryBufferFromUnity* buffer = static_cast<GpuMemoryBufferFromUnity*>(resources->buffer_.get());
+        buffer->ResetCpuReadRequested();
+        resources->inUseBytes_ = buffer->HasCpuReadTexture() ? resources->bytes_ * 2 : resources->bytes_;
         resources->MarkUsed(clock_->CurrentTime());
-        resourcesPool_.push_back(std::move(resources));
-        return std::move(buffer);
     }
 
-    bool GpuMemoryBufferPool::AreFrameResourcesCompatible(
-        const FrameResources* resources, const Size& size, UnityRenderingExtTextureFormat format)
+    void GpuMemoryBufferPool::OnReturnBuffer(Bucket* bucket, SourceBudget* budget, FrameResources* resources)
     {
-        return resources->buffer_->GetSize() == size && resources->buffer_->GetFormat() == format;
+        // This method is called on the encoder thread, so it must not touch anything other than the returned-list
+        // and the atomic members of the budget.
+        Timestamp now = clock_->CurrentTime();
+        GpuMemoryBufferFromUnity* buffer = static_cast<GpuMemoryBufferFromUnity*>(resources->buffer_.get());
+        if (buffer->IsCpuReadRequested())
+            budget->lastCpuReadUs.store(now.us(), std::memory_order_relaxed);
+        budget->latencySumUs.fetch_add((now - resources->lastUseTime()).us(), std::memory_order_relaxed);
+        budget->latencyCount.fetch_add(1, std::memory_order_relaxed);
+        budget->inUseBytes.fetch_sub(resources->inUseBytes_, std::memory_order_relaxed);
+
+        resources->MarkUnused(now);
+        bucket->PushReturned(resources);
+
+        // The budget may be released after this line.
+        budget->inUseCount.fetch_sub(1, std::memory_order_release);
     }
 
-    void GpuMemoryBufferPool::OnReturnBuffer(rtc::scoped_refptr<GpuMemoryBufferInterface> buffer)
+    template<typename Predicate>
+    void GpuMemoryBufferPool::ReleaseFreeBuffers(Bucket* bucket, Predicate shouldRelease)
     {
-        GpuMemoryBufferInterface* ptr = buffer.get();
-        auto result =
-            std::find_if(resourcesPool_.begin(), resourcesPool_.end(), [ptr](std::unique_ptr<FrameResources>& x) {
-                return x->buffer_.get() == ptr;
+        // Only the buffers on the free-list are unused, the others must be kept.
+        FrameResources* alive = nullptr;
+        FrameResources* resources = nullptr;
+        while ((resources = bucket->PopFree()) != nullptr)
+        {
+            if (!shouldRelease(resources))
+            {
+                resources->next_ = alive;
+                alive = resources;
+                continue;
+            }
+            auto& list = bucket->resources_;
+            auto result = std::find_if(list.begin(), list.end(), [resources](std::unique_ptr<FrameResources>& x) {
+                return x.get() == resources;
             });
-        RTC_DCHECK(result != resourcesPool_.end());
+            RTC_DCHECK(result != list.end());
+            GpuMemoryBufferFromUnity* buffer = static_cast<GpuMemoryBufferFromUnity*>(resources->buffer_.get());
+            bufferCount_--;
+            allocatedBytes_ -= buffer->HasCpuReadTexture() ? resources->bytes_ * 2 : resources->bytes_;
+            std::swap(*result, list.back());
+            list.pop_back();
+        }
+        while (alive)
+        {
+            FrameResources* next = alive->next_;
+            bucket->PushFree(alive);
+            alive = next;
+        }
+    }
 
-        (*result)->MarkUnused(clock_->CurrentTime());
+    template<typename Predicate>
+    void GpuMemoryBufferPool::ReleaseCpuReadTextures(Bucket* bucket, Predicate shouldRelease)
+    {
+        auto& list = bucket->cpuReadTextures_;
+        for (auto it = list.begin(); it != list.end();)
+        {
+            if (!shouldRelease(*it))
+            {
+                ++it;
+                continue;
+            }
+            allocatedBytes_ -= it->bytes;
+            it = list.erase(it);
+        }
+    }
+
+    bool GpuMemoryBufferPool::Reserve(size_t bytes, const Bucket* exclude)
+    {
+        if (allocatedBytes_ + bytes <= maxBytes_)
+            return true;
+
+        // The detached textures for CPU readback are released first, then unused buffers of the other buckets.
+        auto exceeded = [this, bytes](auto&) { return allocatedBytes_ + bytes > maxBytes_; };
+        for (auto& pair : buckets_)
+        {
+            ReleaseCpuReadTextures(pair.second.get(), exceeded);
+            if (allocatedBytes_ + bytes <= maxBytes_)
+                return true;
+        }
+        for (auto& pair : buckets_)
+        {
+            Bucket* bucket = pair.second.get();
+            if (bucket == exclude)
+                continue;
+            ReleaseFreeBuffers(bucket, [this, bytes](FrameResources*) { return allocatedBytes_ + bytes > maxBytes_; });
+            if (allocatedBytes_ + bytes <= maxBytes_)
+                return true;
+        }
+        return false;
     }
 
     void GpuMemoryBufferPool::ReleaseStaleBuffers(Timestamp now, TimeDelta timeLimit)
     {
-        auto it = resourcesPool_.begin();
-        for (; it != resourcesPool_.end();)
+        for (auto it = buckets_.begin(); it != buckets_.end();)
         {
-            FrameResources* resources = (*it).get();
+            Bucket* bucket = it->second.get();
+            ReleaseFreeBuffers(bucket, [now, timeLimit](FrameResources* resources) {
+                return now - resources->lastUseTime() > timeLimit;
+            });
+            ReleaseCpuReadTextures(bucket, [now, timeLimit](const CpuReadTexture& texture) {
+                return now - texture.lastUseTime > timeLimit;
+            });
 
-            if (!resources->IsUsed() && now - resources->lastUseTime() > timeLimit)
-            {
-                it = resourcesPool_.erase(it);
-            }
+            if (bucket->resources_.empty() && bucket->cpuReadTextures_.empty())
+                it = buckets_.erase(it);
+            else
+                ++it;
+        }
+
+        for (auto it = sources_.begin(); it != sources_.end();)
+        {
+            SourceBudget* budget = it->second.get();
+            if (budget->inUseCount.load(std::memory_order_acquire) == 0 && now - budget->lastAcquireTime > timeLimit)
+                it = sources_.erase(it);
             else
-            {
                 ++it;
-            }
         }
     }
 }
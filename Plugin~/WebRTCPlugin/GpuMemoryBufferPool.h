@@ -1,9 +1,13 @@
 #pragma once
 
-#include <list>
+#include <absl/types/optional.h>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
 #include <system_wrappers/include/clock.h>
 
 #include "GpuMemoryBuffer.h"
+#include "GraphicsDevice/ITexture2D.h"
 #include "Size.h"
 #include "VideoFrame.h"
 
@@ -14,51 +18,177 @@ namespace webrtc
     class GpuMemoryBufferPool
     {
     public:
-        GpuMemoryBufferPool(IGraphicsDevice* device, Clock* clock);
+        // The reason why CreateFrame method refused to provide a frame to the source.
+        enum class ThrottleReason
+        {
+            kNone,
+            // The source has as many frames in flight as its quota allows.
+            kSourceQuotaExceeded,
+            // The source uses more than its fair share of the byte budget.
+            kSourceByteShareExceeded,
+            // The pool cannot allocate a new buffer without exceeding the byte budget.
+            kByteBudgetExceeded,
+        };
+
+        struct SourceStats
+        {
+            size_t inUseCount;
+            size_t inUseBytes;
+            size_t quota;
+            TimeDelta encodeLatency;
+            TimeDelta captureInterval;
+            uint64_t throttledCount;
+            ThrottleReason lastThrottleReason;
+            bool cpuRead;
+        };
+
+        static constexpr size_t kDefaultMaxBytes = 256 * 1024 * 1024;
+
+        GpuMemoryBufferPool(IGraphicsDevice* device, Clock* clock, size_t maxBytes = kDefaultMaxBytes);
         GpuMemoryBufferPool(const GpuMemoryBufferPool&) = delete;
         GpuMemoryBufferPool& operator=(const GpuMemoryBufferPool&) = delete;
 
         virtual ~GpuMemoryBufferPool();
 
-        rtc::scoped_refptr<VideoFrame>
-        CreateFrame(NativeTexPtr ptr, const Size& size, UnityRenderingExtTextureFormat format, Timestamp timestamp);
+        // Returns nullptr when the frame is throttled by the budget of the |source|.
+        // The reason is stored in |reason| if not nullptr.
+        rtc::scoped_refptr<VideoFrame> CreateFrame(
+            NativeTexPtr ptr,
+            const Size& size,
+            UnityRenderingExtTextureFormat format,
+            Timestamp timestamp,
+            const void* source = nullptr,
+            ThrottleReason* reason = nullptr);
         void ReleaseStaleBuffers(Timestamp timestamp, TimeDelta timeLimit);
 
-        size_t bufferCount() { return resourcesPool_.size(); }
+        size_t bufferCount() { return bufferCount_; }
+        size_t allocatedBytes() { return allocatedBytes_; }
+        size_t maxBytes() { return maxBytes_; }
+        // The number of the buffers taken from the free-lists. An acquire takes one buffer from the bucket unless the
+        // buffer has not signaled yet.
+        uint64_t freeListPopCount() { return freeListPopCount_; }
+        absl::optional<SourceStats> GetSourceStats(const void* source) const;
+
+        // A buffer has a texture for GPU, and one more texture for CPU readback while a software encoder consumes it.
+        static size_t EstimateTextureBytes(const Size& size, UnityRenderingExtTextureFormat format);
 
     private:
+        // Budget of frames for each source. The render thread owns this object, encoder threads only update the
+        // atomic members when returning buffers.
+        struct SourceBudget
+        {
+            SourceBudget(Timestamp timestamp);
+            void UpdateQuota(Timestamp timestamp);
+            bool NeedsCpuRead(Timestamp timestamp) const;
+
+            std::atomic<size_t> inUseCount;
+            std::atomic<size_t> inUseBytes;
+            std::atomic<int64_t> latencySumUs;
+            std::atomic<int64_t> latencyCount;
+            std::atomic<int64_t> lastCpuReadUs;
+            size_t quota;
+            TimeDelta encodeLatency;
+            TimeDelta captureInterval;
+            Timestamp lastAcquireTime;
+            uint64_t throttledCount;
+            ThrottleReason lastThrottleReason;
+        };
+
         struct FrameResources
         {
-            FrameResources(rtc::scoped_refptr<GpuMemoryBufferInterface> buffer)
+            FrameResources(rtc::scoped_refptr<GpuMemoryBufferInterface> buffer, size_t bytes)
                 : buffer_(std::move(buffer))
+                , bytes_(bytes)
+                , inUseBytes_(0)
                 , lastUsetime_(Timestamp::Zero())
+                , next_(nullptr)
             {
             }
             rtc::scoped_refptr<GpuMemoryBufferInterface> buffer_;
-            bool IsUsed() { return isUsed_; }
-            void MarkUsed(Timestamp timestamp)
+            const size_t bytes_;
+            // Bytes of the textures which the frame is holding, including the texture for CPU readback.
+            size_t inUseBytes_;
+            void MarkUsed(Timestamp timestamp) { lastUsetime_ = timestamp; }
+            void MarkUnused(Timestamp timestamp) { lastUsetime_ = timestamp; }
+            Timestamp lastUseTime() { return lastUsetime_; }
+            Timestamp lastUsetime_;
+            // Intrusive link used by the free-list and the returned-list of the bucket.
+            FrameResources* next_;
+        };
+
+        struct CpuReadTexture
+        {
+            std::unique_ptr<ITexture2D> texture;
+            size_t bytes;
+            Timestamp lastUseTime;
+        };
+
+        // Buffers which have the same size and format.
+        // The render thread is the only consumer, so `free_` and `resources_` are accessed without lock.
+        // Encoder threads return buffers by pushing them into `returned_`, which is a lock-free stack.
+        // The render thread takes the whole stack with a single exchange, so the ABA problem never occurs.
+        struct Bucket
+        {
+            Bucket()
+                : returned_(nullptr)
+                , free_(nullptr)
             {
-                isUsed_ = true;
-                lastUsetime_ = timestamp;
             }
-            void MarkUnused(Timestamp timestamp)
+            void PushReturned(FrameResources* resources);
+            void PushFree(FrameResources* resources);
+            FrameResources* PopFree();
+
+            std::atomic<FrameResources*> returned_;
+            FrameResources* free_;
+            std::vector<std::unique_ptr<FrameResources>> resources_;
+            // Textures for CPU readback which are detached from the buffers.
+            std::vector<CpuReadTexture> cpuReadTextures_;
+        };
+
+        struct BucketKey
+        {
+            Size size;
+            UnityRenderingExtTextureFormat format;
+            bool operator==(const BucketKey& other) const { return size == other.size && format == other.format; }
+        };
+
+        struct BucketKeyHash
+        {
+            size_t operator()(const BucketKey& key) const
             {
-                isUsed_ = false;
-                lastUsetime_ = timestamp;
+                size_t hash = std::hash<int>()(key.size.width());
+                hash = hash * 31 + std::hash<int>()(key.size.height());
+                hash = hash * 31 + std::hash<int>()(static_cast<int>(key.format));
+                return hash;
             }
-            Timestamp lastUseTime() { return lastUsetime_; }
-            bool isUsed_;
-            Timestamp lastUsetime_;
         };
-        rtc::scoped_refptr<GpuMemoryBufferInterface>
-        GetOrCreateFrameResources(NativeTexPtr ptr, const Size& size, UnityRenderingExtTextureFormat format);
-        void OnReturnBuffer(rtc::scoped_refptr<GpuMemoryBufferInterface> buffer);
 
-        static bool AreFrameResourcesCompatible(
-            const FrameResources* resources, const Size& size, UnityRenderingExtTextureFormat format);
+        Bucket* GetOrCreateBucket(const Size& size, UnityRenderingExtTextureFormat format);
+        SourceBudget* GetOrCreateSourceBudget(const void* source, Timestamp timestamp);
+        ThrottleReason CheckBudget(const SourceBudget* budget, size_t bytes) const;
+        FrameResources* GetOrCreateFrameResources(
+            Bucket* bucket,
+            NativeTexPtr ptr,
+            const Size& size,
+            UnityRenderingExtTextureFormat format,
+            bool cpuRead,
+            ThrottleReason* reason);
+        bool PrepareCpuReadTexture(Bucket* bucket, GpuMemoryBufferFromUnity* buffer, bool cpuRead);
+        void MarkUsed(FrameResources* resources);
+        void OnReturnBuffer(Bucket* bucket, SourceBudget* budget, FrameResources* resources);
+        template<typename Predicate>
+        void ReleaseFreeBuffers(Bucket* bucket, Predicate shouldRelease);
+        template<typename Predicate>
+        void ReleaseCpuReadTextures(Bucket* bucket, Predicate shouldRelease);
+        bool Reserve(size_t bytes, const Bucket* exclude);
 
         IGraphicsDevice* device_;
-        std::list<std::unique_ptr<FrameResources>> resourcesPool_;
+        std::unordered_map<BucketKey, std::unique_ptr<Bucket>, BucketKeyHash> buckets_;
+        std::unordered_map<const void*, std::unique_ptr<SourceBudget>> sources_;
+        size_t bufferCount_;
+        size_t allocatedBytes_;
+        uint64_t freeListPopCount_;
+        const size_t maxBytes_;
         Clock* const clock_;
     };
 }
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include <third_party/libyuv/include/libyuv/convert.h>
+#include <third_party/libyuv/include/libyuv/convert_from_argb.h>
 
 #include "D3D11GraphicsDevice.h"
 #include "D3D11Texture2D.h"
@@ -185,41 +186,75 @@ namespace webrtc
 
     //---------------------------------------------------------------------------------------------------------------------
 
-    rtc::scoped_refptr<I420Buffer> D3D11GraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    bool D3D11GraphicsDevice::ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback)
     {
         D3D11_MAPPED_SUBRESOURCE pMappedResource;
 
         ID3D11Resource* pResource = reinterpret_cast<ID3D11Resource*>(tex->GetNativeTexturePtrV());
         if (nullptr == pResource)
-            return nullptr;
+            return false;
 
         ComPtr<ID3D11DeviceContext> context;
         m_d3d11Device->GetImmediateContext(context.GetAddressOf());
 
         const HRESULT hr = context->Map(pResource, 0, D3D11_MAP_READ, 0, &pMappedResource);
         if (hr != S_OK)
-            return nullptr;
+            return false;
+
+        callback(static_cast<const uint8_t*>(pMappedResource.pData), static_cast<int32_t>(pMappedResource.RowPitch));
 
+        context->Unmap(pResource, 0);
+        return true;
+    }
+
+    rtc::scoped_refptr<I420Buffer> D3D11GraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    {
         const int32_t width = static_cast<int32_t>(tex->GetWidth());
         const int32_t height = static_cast<int32_t>(tex->GetHeight());
 
-        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer = webrtc::I420Buffer::Create(width, height);
-        libyuv::ARGBToI420(
-            static_cast<uint8_t*>(pMappedResource.pData),
-            static_cast<int32_t>(pMappedResource.RowPitch),
-            i420_buffer->MutableDataY(),
-            i420_buffer->StrideY(),
-            i420_buffer->MutableDataU(),
-            i420_buffer->StrideU(),
-            i420_buffer->MutableDataV(),
-            i420_buffer->StrideV(),
-            width,
-            height);
-
-        context->Unmap(pResource, 0);
+        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer = m_frameBufferPool.CreateI420Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToI420(
+                data,
+                stride,
+                i420_buffer->MutableDataY(),
+                i420_buffer->StrideY(),
+                i420_buffer->MutableDataU(),
+                i420_buffer->StrideU(),
+                i420_buffer->MutableDataV(),
+                i420_buffer->StrideV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
         return i420_buffer;
     }
 
+    rtc::scoped_refptr<NV12Buffer> D3D11GraphicsDevice::ConvertRGBToNV12(ITexture2D* tex)
+    {
+        const int32_t width = static_cast<int32_t>(tex->GetWidth());
+        const int32_t height = static_cast<int32_t>(tex->GetHeight());
+
+        rtc::scoped_refptr<webrtc::NV12Buffer> nv12_buffer = m_frameBufferPool.CreateNV12Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToNV12(
+                data,
+                stride,
+                nv12_buffer->MutableDataY(),
+                nv12_buffer->StrideY(),
+                nv12_buffer->MutableDataUV(),
+                nv12_buffer->StrideUV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
+        return nv12_buffer;
+    }
+
     std::unique_ptr<GpuMemoryBufferHandle> D3D11GraphicsDevice::Map(ITexture2D* texture)
     {
         if (!IsCudaSupport())
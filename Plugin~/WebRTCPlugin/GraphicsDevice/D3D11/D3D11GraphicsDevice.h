@@ -34,12 +34,14 @@ namespace webrtc
         bool WaitSync(const ITexture2D* texture, uint64_t nsTimeout = 0) override;
         bool ResetSync(const ITexture2D* texture) override;
         virtual rtc::scoped_refptr<::webrtc::I420Buffer> ConvertRGBToI420(ITexture2D* tex) override;
+        virtual rtc::scoped_refptr<::webrtc::NV12Buffer> ConvertRGBToNV12(ITexture2D* tex) override;
         bool IsCudaSupport() override { return m_isCudaSupport; }
         CUcontext GetCUcontext() override { return m_cudaContext.GetContext(); }
         NV_ENC_BUFFER_FORMAT GetEncodeBufferFormat() override { return NV_ENC_BUFFER_FORMAT_ARGB; }
 
     private:
         HRESULT Signal(ID3D11Fence* fence);
+        bool ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback);
         ID3D11Device* m_d3d11Device;
 
         bool m_isCudaSupport;
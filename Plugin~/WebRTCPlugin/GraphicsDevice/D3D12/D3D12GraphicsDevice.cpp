@@ -262,20 +262,18 @@ namespace webrtc
     }
 
     //----------------------------------------------------------------------------------------------------------------------
-    rtc::scoped_refptr<webrtc::I420Buffer> D3D12GraphicsDevice::ConvertRGBToI420(ITexture2D* baseTex)
+    bool D3D12GraphicsDevice::ReadPixels(ITexture2D* baseTex, const ReadPixelsCallback& callback)
     {
         D3D12Texture2D* tex = reinterpret_cast<D3D12Texture2D*>(baseTex);
         assert(nullptr != tex);
         if (nullptr == tex)
-            return nullptr;
+            return false;
 
         ID3D12Resource* readbackResource = tex->GetReadbackResource();
         assert(nullptr != readbackResource);
         if (nullptr == readbackResource) // the texture has to be prepared for CPU access
-            return nullptr;
+            return false;
 
-        const int width = static_cast<int>(tex->GetWidth());
-        const int height = static_cast<int>(tex->GetHeight());
         const D3D12ResourceFootprint* footprint = tex->GetNativeTextureFootprint();
         const int rowPitch = static_cast<int>(footprint->Footprint.Footprint.RowPitch);
 
@@ -285,29 +283,68 @@ namespace webrtc
         assert(hr == S_OK);
         if (hr != S_OK)
         {
-            return nullptr;
+            return false;
         }
 
-        // RGBA -> I420
-        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer = webrtc::I420Buffer::Create(width, height);
-        libyuv::ARGBToI420(
-            static_cast<uint8_t*>(data),
-            rowPitch,
-            i420_buffer->MutableDataY(),
-            i420_buffer->StrideY(),
-            i420_buffer->MutableDataU(),
-            i420_buffer->StrideU(),
-            i420_buffer->MutableDataV(),
-            i420_buffer->StrideV(),
-            width,
-            height);
+        callback(static_cast<const uint8_t*>(data), rowPitch);
 
         D3D12_RANGE emptyRange { 0, 0 };
         readbackResource->Unmap(0, &emptyRange);
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    rtc::scoped_refptr<webrtc::I420Buffer> D3D12GraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    {
+        const int width = static_cast<int>(tex->GetWidth());
+        const int height = static_cast<int>(tex->GetHeight());
 
+        // RGBA -> I420
+        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer = m_frameBufferPool.CreateI420Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToI420(
+                data,
+                stride,
+                i420_buffer->MutableDataY(),
+                i420_buffer->StrideY(),
+                i420_buffer->MutableDataU(),
+                i420_buffer->StrideU(),
+                i420_buffer->MutableDataV(),
+                i420_buffer->StrideV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
         return i420_buffer;
     }
 
+    //----------------------------------------------------------------------------------------------------------------------
+    rtc::scoped_refptr<webrtc::NV12Buffer> D3D12GraphicsDevice::ConvertRGBToNV12(ITexture2D* tex)
+    {
+        const int width = static_cast<int>(tex->GetWidth());
+        const int height = static_cast<int>(tex->GetHeight());
+
+        // RGBA -> NV12
+        rtc::scoped_refptr<webrtc::NV12Buffer> nv12_buffer = m_frameBufferPool.CreateNV12Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToNV12(
+                data,
+                stride,
+                nv12_buffer->MutableDataY(),
+                nv12_buffer->StrideY(),
+                nv12_buffer->MutableDataUV(),
+                nv12_buffer->StrideUV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
+        return nv12_buffer;
+    }
+
     std::unique_ptr<GpuMemoryBufferHandle> D3D12GraphicsDevice::Map(ITexture2D* texture)
     {
         if (!IsCudaSupport())
@@ -0,0 +1,122 @@
+#include "pch.h"
+
+#include <algorithm>
+
+#include "FrameBufferPool.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    FrameBufferPool::ResolutionPool::ResolutionPool(
+        int width, int height, VideoFrameBuffer::Type type, size_t maxBuffers)
+        : width(width)
+        , height(height)
+        , type(type)
+        , lastUseCount(0)
+        , pool(false, maxBuffers)
+    {
+    }
+
+    FrameBufferPool::FrameBufferPool(size_t maxBuffersPerResolution, size_t maxResolutions)
+        : maxBuffersPerResolution_(maxBuffersPerResolution)
+        , maxResolutions_(maxResolutions)
+        , useCount_(0)
+        , hitCount_(0)
+        , missCount_(0)
+    {
+        RTC_DCHECK_GT(maxBuffersPerResolution_, 0);
+        RTC_DCHECK_GT(maxResolutions_, 0);
+    }
+
+    rtc::scoped_refptr<I420Buffer> FrameBufferPool::CreateI420Buffer(int width, int height)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ResolutionPool* resolutionPool = GetOrCreateResolutionPool(width, height, VideoFrameBuffer::Type::kI420);
+            rtc::scoped_refptr<I420Buffer> buffer = resolutionPool->pool.CreateI420Buffer(width, height);
+            if (buffer)
+            {
+                CountHitOrMiss(resolutionPool, buffer.get());
+                return buffer;
+            }
+        }
+        // All buffers of the resolution are still referenced by the encoders.
+        missCount_++;
+        return I420Buffer::Create(width, height);
+    }
+
+    rtc::scoped_refptr<NV12Buffer> FrameBufferPool::CreateNV12Buffer(int width, int height)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ResolutionPool* resolutionPool = GetOrCreateResolutionPool(width, height, VideoFrameBuffer::Type::kNV12);
+            rtc::scoped_refptr<NV12Buffer> buffer = resolutionPool->pool.CreateNV12Buffer(width, height);
+            if (buffer)
+            {
+                CountHitOrMiss(resolutionPool, buffer.get());
+                return buffer;
+            }
+        }
+        missCount_++;
+        return NV12Buffer::Create(width, height);
+    }
+
+    void FrameBufferPool::Release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pools_.clear();
+    }
+
+    FrameBufferPool::Stats FrameBufferPool::GetStats() const
+    {
+        Stats stats;
+        stats.hitCount = hitCount_.load();
+        stats.missCount = missCount_.load();
+        return stats;
+    }
+
+    void FrameBufferPool::CountHitOrMiss(ResolutionPool* resolutionPool, const VideoFrameBuffer* buffer)
+    {
+        std::vector<const VideoFrameBuffer*>& buffers = resolutionPool->buffers;
+        if (std::find(buffers.begin(), buffers.end(), buffer) != buffers.end())
+        {
+            hitCount_++;
+            return;
+        }
+        buffers.push_back(buffer);
+        missCount_++;
+    }
+
+    FrameBufferPool::ResolutionPool*
+    FrameBufferPool::GetOrCreateResolutionPool(int width, int height, VideoFrameBuffer::Type type)
+    {
+        useCount_++;
+        for (auto& pool : pools_)
+        {
+            if (pool->width == width && pool->height == height && pool->type == type)
+            {
+                pool->lastUseCount = useCount_;
+                return pool.get();
+            }
+        }
+
+        // Drop the pool of the resolution which is least recently used.
+        if (pools_.size() >= maxResolutions_)
+        {
+            auto it = std::min_element(
+                pools_.begin(),
+                pools_.end(),
+                [](const std::unique_ptr<ResolutionPool>& a, const std::unique_ptr<ResolutionPool>& b)
+                { return a->lastUseCount < b->lastUseCount; });
+            pools_.erase(it);
+        }
+        pools_.push_back(std::make_unique<ResolutionPool>(width, height, type, maxBuffersPerResolution_));
+        pools_.back()->lastUseCount = useCount_;
+        return pools_.back().get();
+    }
+
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <api/video/i420_buffer.h>
+#include <api/video/nv12_buffer.h>
+#include <common_video/include/video_frame_buffer_pool.h>
+
+namespace unity
+{
+namespace webrtc
+{
+    // Pool of I420 and NV12 buffers for the conversion from the readback textures.
+    // webrtc::VideoFrameBufferPool drops all buffers when the requested resolution or type changes, so a pool is kept
+    // for each of them. This class is thread-safe because the encoders of the tracks convert on their own threads.
+    class FrameBufferPool
+    {
+    public:
+        struct Stats
+        {
+            uint64_t hitCount = 0;
+            uint64_t missCount = 0;
+        };
+
+        static const size_t kDefaultMaxBuffersPerResolution = 8;
+        static const size_t kDefaultMaxResolutions = 4;
+
+        explicit FrameBufferPool(
+            size_t maxBuffersPerResolution = kDefaultMaxBuffersPerResolution,
+            size_t maxResolutions = kDefaultMaxResolutions);
+        ~FrameBufferPool() = default;
+
+        // Returns the buffer which is not referenced anywhere else. These never return nullptr, a new buffer is
+        // allocated out of the pool when all buffers of the resolution are in use.
+        rtc::scoped_refptr<::webrtc::I420Buffer> CreateI420Buffer(int width, int height);
+        rtc::scoped_refptr<::webrtc::NV12Buffer> CreateNV12Buffer(int width, int height);
+        void Release();
+        Stats GetStats() const;
+
+    private:
+        struct ResolutionPool
+        {
+            ResolutionPool(int width, int height, ::webrtc::VideoFrameBuffer::Type type, size_t maxBuffers);
+
+            int width;
+            int height;
+            ::webrtc::VideoFrameBuffer::Type type;
+            uint64_t lastUseCount;
+            ::webrtc::VideoFrameBufferPool pool;
+            // Buffers which the pool has returned once, to tell a reuse from an allocation.
+            std::vector<const ::webrtc::VideoFrameBuffer*> buffers;
+        };
+
+        ResolutionPool* GetOrCreateResolutionPool(int width, int height, ::webrtc::VideoFrameBuffer::Type type);
+        void CountHitOrMiss(ResolutionPool* resolutionPool, const ::webrtc::VideoFrameBuffer* buffer);
+
+        const size_t maxBuffersPerResolution_;
+        const size_t maxResolutions_;
+        std::mutex mutex_;
+        std::vector<std::unique_ptr<ResolutionPool>> pools_;
+        uint64_t useCount_;
+        std::atomic<uint64_t> hitCount_;
+        std::atomic<uint64_t> missCount_;
+    };
+
+} // end namespace webrtc
+} // end namespace unity
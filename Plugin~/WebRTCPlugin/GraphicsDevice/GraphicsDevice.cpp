@@ -90,6 +90,11 @@ namespace webrtc
             RTC_DCHECK_NOTREACHED();
             return nullptr;
         }
+        rtc::scoped_refptr<::webrtc::NV12Buffer> ConvertRGBToNV12(ITexture2D* tex) override
+        {
+            RTC_DCHECK_NOTREACHED();
+            return nullptr;
+        }
 
 #if CUDA_PLATFORM
         bool IsCudaSupport() override { return false; }
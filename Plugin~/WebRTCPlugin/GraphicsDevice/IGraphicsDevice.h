@@ -1,10 +1,12 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include <IUnityRenderingExtensions.h>
 #include <api/video/i420_buffer.h>
 
+#include "FrameBufferPool.h"
 #include "PlatformBase.h"
 #include "ProfilerMarkerFactory.h"
 #include "ScopedProfiler.h"
@@ -53,10 +55,17 @@ namespace webrtc
         virtual ITexture2D*
         CreateCPUReadTextureV(uint32_t width, uint32_t height, UnityRenderingExtTextureFormat textureFormat) = 0;
         virtual rtc::scoped_refptr<::webrtc::I420Buffer> ConvertRGBToI420(ITexture2D* tex) = 0;
+        virtual rtc::scoped_refptr<::webrtc::NV12Buffer> ConvertRGBToNV12(ITexture2D* tex) = 0;
+        FrameBufferPool::Stats GetFrameBufferPoolStats() const { return m_frameBufferPool.GetStats(); }
 
     protected:
+        // Called with the pixels of the texture for CPU readback while they are mapped to the main memory.
+        using ReadPixelsCallback = std::function<void(const uint8_t* data, int32_t stride)>;
+
         UnityGfxRenderer m_gfxRenderer;
         ProfilerMarkerFactory* m_profiler;
+        // The destination buffers of ConvertRGBToI420 and ConvertRGBToNV12.
+        FrameBufferPool m_frameBufferPool;
     };
 
 } // end namespace webrtc
@@ -29,12 +29,14 @@ namespace webrtc
         bool CopyResourceV(ITexture2D* dest, ITexture2D* src) override;
         bool CopyResourceFromNativeV(ITexture2D* dest, void* nativeTexturePtr) override;
         rtc::scoped_refptr<I420Buffer> ConvertRGBToI420(ITexture2D* tex) override;
+        rtc::scoped_refptr<NV12Buffer> ConvertRGBToNV12(ITexture2D* tex) override;
         std::unique_ptr<GpuMemoryBufferHandle> Map(ITexture2D* texture) override { return nullptr; }
 
     private:
         MetalDevice* m_device;
         id<MTLCommandQueue> m_queue;
         bool CopyTexture(id<MTLTexture> dest, id<MTLTexture> src);
+        bool ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback);
         static MTLPixelFormat ConvertFormat(UnityRenderingExtTextureFormat format);
     };
 
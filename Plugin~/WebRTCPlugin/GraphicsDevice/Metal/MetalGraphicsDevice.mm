@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include <third_party/libyuv/include/libyuv/convert.h>
+#include <third_party/libyuv/include/libyuv/convert_from_argb.h>
 
 #include "GraphicsDevice/GraphicsUtility.h"
 #include "MetalDevice.h"
@@ -131,7 +132,7 @@ namespace webrtc
         return new MetalTexture2D(width, height, texture);
     }
 
-    rtc::scoped_refptr<webrtc::I420Buffer> MetalGraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    bool MetalGraphicsDevice::ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback)
     {
         id<MTLTexture> source = (__bridge id<MTLTexture>)tex->GetNativeTexturePtrV();
         const uint32_t width = tex->GetWidth();
@@ -153,22 +154,58 @@ namespace webrtc
               fromRegion:MTLRegionMake2D(0, 0, width, height)
              mipmapLevel:0];
 
-        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer =
-            webrtc::I420Buffer::Create(static_cast<int32_t>(width), static_cast<int32_t>(height));
-        libyuv::ARGBToI420(
-            buffer.data(),
-            static_cast<int32_t>(bytesPerRow),
-            i420_buffer->MutableDataY(),
-            i420_buffer->StrideY(),
-            i420_buffer->MutableDataU(),
-            i420_buffer->StrideU(),
-            i420_buffer->MutableDataV(),
-            i420_buffer->StrideV(),
-            static_cast<int32_t>(width),
-            static_cast<int32_t>(height));
+        callback(buffer.data(), static_cast<int32_t>(bytesPerRow));
+        return true;
+    }
+
+    rtc::scoped_refptr<webrtc::I420Buffer> MetalGraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    {
+        const int32_t width = static_cast<int32_t>(tex->GetWidth());
+        const int32_t height = static_cast<int32_t>(tex->GetHeight());
+
+        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer = m_frameBufferPool.CreateI420Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToI420(
+                data,
+                stride,
+                i420_buffer->MutableDataY(),
+                i420_buffer->StrideY(),
+                i420_buffer->MutableDataU(),
+                i420_buffer->StrideU(),
+                i420_buffer->MutableDataV(),
+                i420_buffer->StrideV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
         return i420_buffer;
     }
 
+    rtc::scoped_refptr<webrtc::NV12Buffer> MetalGraphicsDevice::ConvertRGBToNV12(ITexture2D* tex)
+    {
+        const int32_t width = static_cast<int32_t>(tex->GetWidth());
+        const int32_t height = static_cast<int32_t>(tex->GetHeight());
+
+        rtc::scoped_refptr<webrtc::NV12Buffer> nv12_buffer = m_frameBufferPool.CreateNV12Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToNV12(
+                data,
+                stride,
+                nv12_buffer->MutableDataY(),
+                nv12_buffer->StrideY(),
+                nv12_buffer->MutableDataUV(),
+                nv12_buffer->StrideUV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
+        return nv12_buffer;
+    }
+
     MTLPixelFormat MetalGraphicsDevice::ConvertFormat(UnityRenderingExtTextureFormat format)
     {
         switch (format)
@@ -38,6 +38,33 @@ namespace webrtc
         return Size(width, height);
     }
 
+    void GetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void* pixels)
+    {
+#if SUPPORT_OPENGL_CORE
+        glGetTexImage(target, level, format, type, pixels);
+#elif SUPPORT_OPENGL_ES
+        // This is called on the render thread, so restore the framebuffer which Unity has bound.
+        GLint prevFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[0]);
+
+        int width = 0;
+        int height = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+
+        GLint tex;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &tex);
+
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+
+        // read pixels from framebuffer to PBO
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, width, height, format, type, pixels);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevFramebuffer));
+#endif
+    }
+
     OpenGLGraphicsDevice::OpenGLGraphicsDevice(UnityGfxRenderer renderer, ProfilerMarkerFactory* profiler)
         : IGraphicsDevice(renderer, profiler)
         , mainContext_(nullptr)
@@ -111,20 +138,19 @@ namespace webrtc
         OpenGLTexture2D* srcTexture = static_cast<OpenGLTexture2D*>(src);
         OpenGLTexture2D* dstTexture = static_cast<OpenGLTexture2D*>(dst);
         const GLuint srcName = srcTexture->GetTexture();
-        const GLuint dstName = dstTexture->GetTexture();
-        return CopyResource(dstName, srcName);
+        return CopyResource(dstTexture, srcName);
     }
 
     bool OpenGLGraphicsDevice::CopyResourceFromNativeV(ITexture2D* dst, void* nativeTexturePtr)
     {
         OpenGLTexture2D* dstTexture = static_cast<OpenGLTexture2D*>(dst);
         const GLuint srcName = reinterpret_cast<uintptr_t>(nativeTexturePtr);
-        const GLuint dstName = dstTexture->GetTexture();
-        return CopyResource(dstName, srcName);
+        return CopyResource(dstTexture, srcName);
     }
 
-    bool OpenGLGraphicsDevice::CopyResource(GLuint dstName, GLuint srcName)
+    bool OpenGLGraphicsDevice::CopyResource(OpenGLTexture2D* dst, GLuint srcName)
     {
+        const GLuint dstName = dst->GetTexture();
         if (srcName == dstName)
         {
             RTC_LOG(LS_INFO) << "Same texture";
@@ -174,89 +200,153 @@ namespace webrtc
             dstSize.height(),
             1);
 
-        // todo(kazuki): "glFinish" is used to sync GPU for waiting to copy the texture buffer.
-        // But this command affects graphics performance.
-        glFinish();
+        // Queue the readback into the PBO right after the copy, so that the transfer to the main memory overlaps
+        // the rendering of the following frames instead of stalling the encoder thread.
+        const GLuint pbo = dst->GetPBO();
+        if (pbo != 0)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+            glBindTexture(GL_TEXTURE_2D, dstName);
+            GetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
 
+        // Insert the fence instead of "glFinish" which blocks the render thread until GPU is idle.
+        // "glFlush" makes sure the fence is submitted so that the other contexts can wait for it.
+        dst->SetSync(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        glFlush();
         return true;
     }
 
-    void OpenGLGraphicsDevice::ReleaseTexture(OpenGLTexture2D* texture)
+    bool OpenGLGraphicsDevice::WaitSync(const ITexture2D* texture, uint64_t nsTimeout)
     {
-        if (!OpenGLContext::CurrentContext())
-            contexts_.push_back(OpenGLContext::CreateGLContext(mainContext_.get()));
-        texture->Release();
+        const OpenGLTexture2D* glTexture2D = static_cast<const OpenGLTexture2D*>(texture);
+        GLsync sync = glTexture2D->GetSync();
+        if (!sync)
+            return true;
+
+        EnsureCurrentContext();
+        const GLenum result = glClientWaitSync(sync, 0, nsTimeout);
+        if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+        {
+            RTC_LOG(LS_INFO) << "glClientWaitSync failed. result:" << result;
+            return false;
+        }
+        return true;
     }
 
-    void GetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void* pixels)
+    bool OpenGLGraphicsDevice::ResetSync(const ITexture2D* texture)
     {
-#if SUPPORT_OPENGL_CORE
-        glGetTexImage(target, level, format, type, pixels);
-#elif SUPPORT_OPENGL_ES
-        glBindFramebuffer(GL_FRAMEBUFFER, fbo[0]);
-
-        int width = 0;
-        int height = 0;
-        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
-
-        GLint tex;
-        glGetIntegerv(GL_TEXTURE_BINDING_2D, &tex);
-
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+        const OpenGLTexture2D* glTexture2D = static_cast<const OpenGLTexture2D*>(texture);
+        GLsync sync = glTexture2D->GetSync();
+        if (!sync)
+            return true;
+
+        // Poll without blocking. The texture is not reused until the previous copy is completed.
+        GLint status = GL_UNSIGNALED;
+        glGetSynciv(sync, GL_SYNC_STATUS, sizeof(status), nullptr, &status);
+        if (status != GL_SIGNALED)
+            return false;
+        glTexture2D->DeleteSync();
+        return true;
+    }
 
-        // read pixels from framebuffer to PBO
-        glReadBuffer(GL_COLOR_ATTACHMENT0);
-        glReadPixels(0, 0, width, height, format, type, pixels);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-#endif
+    bool OpenGLGraphicsDevice::WaitIdleForTest()
+    {
+        glFinish();
+        return true;
     }
 
-    rtc::scoped_refptr<webrtc::I420Buffer> OpenGLGraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    void OpenGLGraphicsDevice::EnsureCurrentContext()
     {
         if (!OpenGLContext::CurrentContext())
             contexts_.push_back(OpenGLContext::CreateGLContext(mainContext_.get()));
+    }
+
+    void OpenGLGraphicsDevice::ReleaseTexture(OpenGLTexture2D* texture)
+    {
+        EnsureCurrentContext();
+        texture->Release();
+    }
+
+    bool OpenGLGraphicsDevice::ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback)
+    {
+        EnsureCurrentContext();
 
         OpenGLTexture2D* sourceTex = static_cast<OpenGLTexture2D*>(tex);
-        const GLuint sourceId = reinterpret_cast<uintptr_t>(sourceTex->GetNativeTexturePtrV());
         const GLuint pbo = sourceTex->GetPBO();
-        const GLenum format = GL_RGBA;
-        const uint32_t width = sourceTex->GetWidth();
-        const uint32_t height = sourceTex->GetHeight();
         const uint32_t bufferSize = sourceTex->GetBufferSize();
-        byte* data = sourceTex->GetBuffer();
 
+        // The readback into the PBO has been issued on the render thread with the copy.
+        // Mapping the buffer waits only for the transfer which has not been completed yet.
         glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
-        glBindTexture(GL_TEXTURE_2D, sourceId);
-
-        GetTexImage(GL_TEXTURE_2D, 0, format, GL_UNSIGNED_BYTE, nullptr);
-
-        // Send PBO to main memory
-        GLubyte* pboPtr = static_cast<GLubyte*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, GL_MAP_READ_BIT));
-        if (pboPtr)
+        const GLubyte* pboPtr =
+            static_cast<const GLubyte*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, GL_MAP_READ_BIT));
+        if (!pboPtr)
         {
-            std::memcpy(data, pboPtr, bufferSize);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            RTC_LOG(LS_INFO) << "glMapBufferRange failed.";
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            return false;
         }
-        glBindTexture(GL_TEXTURE_2D, 0);
+
+        callback(pboPtr, static_cast<int32_t>(sourceTex->GetPitch()));
+
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return true;
+    }
+
+    rtc::scoped_refptr<webrtc::I420Buffer> OpenGLGraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    {
+        const int width = static_cast<int>(tex->GetWidth());
+        const int height = static_cast<int>(tex->GetHeight());
 
         // RGBA -> I420
-        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer = webrtc::I420Buffer::Create(width, height);
-        libyuv::ABGRToI420(
-            static_cast<uint8_t*>(data),
-            width * 4,
-            i420_buffer->MutableDataY(),
-            width,
-            i420_buffer->MutableDataU(),
-            (width + 1) / 2,
-            i420_buffer->MutableDataV(),
-            (width + 1) / 2,
-            width,
-            height);
+        rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer = m_frameBufferPool.CreateI420Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ABGRToI420(
+                data,
+                stride,
+                i420_buffer->MutableDataY(),
+                i420_buffer->StrideY(),
+                i420_buffer->MutableDataU(),
+                i420_buffer->StrideU(),
+                i420_buffer->MutableDataV(),
+                i420_buffer->StrideV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
         return i420_buffer;
     }
 
+    rtc::scoped_refptr<webrtc::NV12Buffer> OpenGLGraphicsDevice::ConvertRGBToNV12(ITexture2D* tex)
+    {
+        const int width = static_cast<int>(tex->GetWidth());
+        const int height = static_cast<int>(tex->GetHeight());
+
+        // RGBA -> NV12
+        rtc::scoped_refptr<webrtc::NV12Buffer> nv12_buffer = m_frameBufferPool.CreateNV12Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ABGRToNV12(
+                data,
+                stride,
+                nv12_buffer->MutableDataY(),
+                nv12_buffer->StrideY(),
+                nv12_buffer->MutableDataUV(),
+                nv12_buffer->StrideUV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
+        return nv12_buffer;
+    }
+
     std::unique_ptr<GpuMemoryBufferHandle> OpenGLGraphicsDevice::Map(ITexture2D* texture)
     {
 #if CUDA_PLATFORM
@@ -268,8 +358,7 @@ namespace webrtc
         std::unique_ptr<GpuMemoryBufferCudaHandle> handle = std::make_unique<GpuMemoryBufferCudaHandle>();
         handle->context = GetCUcontext();
 
-        if (!OpenGLContext::CurrentContext())
-            contexts_.push_back(OpenGLContext::CreateGLContext(mainContext_.get()));
+        EnsureCurrentContext();
 
         OpenGLTexture2D* glTexture2D = static_cast<OpenGLTexture2D*>(texture);
         GMB_CUDA_CALL_NULLPTR(cuGraphicsGLRegisterImage(
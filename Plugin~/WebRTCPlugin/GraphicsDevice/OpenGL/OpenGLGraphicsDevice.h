@@ -35,8 +35,12 @@ namespace webrtc
         CreateCPUReadTextureV(uint32_t width, uint32_t height, UnityRenderingExtTextureFormat textureFormat) override;
         bool CopyResourceV(ITexture2D* dest, ITexture2D* src) override;
         rtc::scoped_refptr<webrtc::I420Buffer> ConvertRGBToI420(ITexture2D* tex) override;
+        rtc::scoped_refptr<webrtc::NV12Buffer> ConvertRGBToNV12(ITexture2D* tex) override;
         bool CopyResourceFromNativeV(ITexture2D* dest, void* nativeTexturePtr) override;
         std::unique_ptr<GpuMemoryBufferHandle> Map(ITexture2D* texture) override;
+        bool WaitSync(const ITexture2D* texture, uint64_t nsTimeout = 0) override;
+        bool ResetSync(const ITexture2D* texture) override;
+        bool WaitIdleForTest() override;
 
 #if CUDA_PLATFORM
         bool IsCudaSupport() override { return m_isCudaSupport; }
@@ -45,7 +49,9 @@ namespace webrtc
 #endif
 
     private:
-        bool CopyResource(GLuint dstName, GLuint srcName);
+        bool CopyResource(OpenGLTexture2D* dst, GLuint srcName);
+        void EnsureCurrentContext();
+        bool ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback);
         void ReleaseTexture(OpenGLTexture2D* texture);
 #if CUDA_PLATFORM
         CudaContext m_cudaContext;
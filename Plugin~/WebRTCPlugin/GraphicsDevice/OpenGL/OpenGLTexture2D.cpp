@@ -18,6 +18,7 @@ namespace webrtc
         : ITexture2D(w, h)
         , m_texture(tex)
         , m_pbo(0)
+        , m_sync(nullptr)
         , m_callback(callback)
     {
         RTC_DCHECK(m_texture);
@@ -27,6 +28,8 @@ namespace webrtc
 
     void OpenGLTexture2D::Release()
     {
+        DeleteSync();
+
         if (glIsTexture(m_texture))
         {
             glDeleteTextures(1, &m_texture);
@@ -43,14 +46,27 @@ namespace webrtc
         RTC_DCHECK_EQ(m_pbo, 0);
 
         glGenBuffers(1, &m_pbo);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbo);
 
+        // The buffer is written by GPU and read by CPU.
         const size_t bufferSize = GetBufferSize();
-        glBufferData(GL_PIXEL_UNPACK_BUFFER, bufferSize, nullptr, GL_DYNAMIC_DRAW);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    void OpenGLTexture2D::SetSync(GLsync sync) const
+    {
+        DeleteSync();
+        m_sync = sync;
+    }
 
-        if (m_buffer.empty())
-            m_buffer.resize(bufferSize);
+    void OpenGLTexture2D::DeleteSync() const
+    {
+        if (m_sync)
+        {
+            glDeleteSync(m_sync);
+            m_sync = nullptr;
+        }
     }
 } // end namespace webrtc
 } // end namespace unity
\ No newline at end of file
@@ -31,15 +31,19 @@ namespace webrtc
         void CreatePBO();
         size_t GetBufferSize() const { return m_width * m_height * 4; }
         size_t GetPitch() const { return m_width * 4; }
-        byte* GetBuffer() { return m_buffer.data(); }
         GLuint GetPBO() const { return m_pbo; }
         GLuint GetTexture() const { return m_texture; }
+
+        // The fence signaled when the last copy (and the readback into the PBO) is completed.
+        void SetSync(GLsync sync) const;
+        GLsync GetSync() const { return m_sync; }
+        void DeleteSync() const;
         void Release();
 
     private:
         GLuint m_texture;
         GLuint m_pbo;
-        std::vector<byte> m_buffer;
+        mutable GLsync m_sync;
         ReleaseOpenGLTextureCallback m_callback;
     };
 
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include <third_party/libyuv/include/libyuv/convert.h>
+#include <third_party/libyuv/include/libyuv/convert_from_argb.h>
 
 #include "GraphicsDevice/GraphicsUtility.h"
 #include "UnityVulkanInterfaceFunctions.h"
@@ -81,6 +82,7 @@ namespace webrtc
         m_cudaContext.Shutdown();
 #endif
         VULKAN_SAFE_DESTROY_COMMAND_POOL(m_device, m_commandPool, m_allocator)
+        m_frameBufferPool.Release();
 
         s_GraphicsDevice = nullptr;
     }
@@ -337,46 +339,74 @@ namespace webrtc
         return vkCreateCommandPool(m_device, &poolInfo, m_allocator, &m_commandPool);
     }
 
-    rtc::scoped_refptr<webrtc::I420Buffer> VulkanGraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    bool VulkanGraphicsDevice::ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback)
     {
         VulkanTexture2D* vulkanTexture = static_cast<VulkanTexture2D*>(tex);
-        const int32_t width = static_cast<int32_t>(tex->GetWidth());
-        const int32_t height = static_cast<int32_t>(tex->GetHeight());
-        const VkDeviceMemory dstImageMemory = vulkanTexture->GetTextureImageMemory();
         VkImageSubresource subresource { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0 };
         VkSubresourceLayout subresourceLayout;
         vkGetImageSubresourceLayout(m_device, vulkanTexture->GetImage(), &subresource, &subresourceLayout);
         const int32_t rowPitch = static_cast<int32_t>(subresourceLayout.rowPitch);
 
-        void* data;
-        std::vector<uint8_t> dst;
-        dst.resize(vulkanTexture->GetTextureImageMemorySize());
-        const VkResult result = vkMapMemory(m_device, dstImageMemory, 0, VK_WHOLE_SIZE, 0, &data);
-        if (result != VK_SUCCESS)
+        const uint8_t* data = vulkanTexture->GetMappedData();
+        if (!data)
         {
-            return nullptr;
+            RTC_LOG(LS_INFO) << "The texture is not mapped for CPU readback.";
+            return false;
         }
-        std::memcpy(static_cast<void*>(dst.data()), data, dst.size());
-
-        vkUnmapMemory(m_device, dstImageMemory);
-
-        // convert format to i420
-        rtc::scoped_refptr<webrtc::I420Buffer> i420Buffer = webrtc::I420Buffer::Create(width, height);
-        libyuv::ARGBToI420(
-            dst.data(),
-            rowPitch,
-            i420Buffer->MutableDataY(),
-            i420Buffer->StrideY(),
-            i420Buffer->MutableDataU(),
-            i420Buffer->StrideU(),
-            i420Buffer->MutableDataV(),
-            i420Buffer->StrideV(),
-            width,
-            height);
 
+        // convert format directly from the mapped memory
+        callback(data + subresourceLayout.offset, rowPitch);
+        return true;
+    }
+
+    rtc::scoped_refptr<webrtc::I420Buffer> VulkanGraphicsDevice::ConvertRGBToI420(ITexture2D* tex)
+    {
+        const int32_t width = static_cast<int32_t>(tex->GetWidth());
+        const int32_t height = static_cast<int32_t>(tex->GetHeight());
+
+        rtc::scoped_refptr<webrtc::I420Buffer> i420Buffer = m_frameBufferPool.CreateI420Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToI420(
+                data,
+                stride,
+                i420Buffer->MutableDataY(),
+                i420Buffer->StrideY(),
+                i420Buffer->MutableDataU(),
+                i420Buffer->StrideU(),
+                i420Buffer->MutableDataV(),
+                i420Buffer->StrideV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
         return i420Buffer;
     }
 
+    rtc::scoped_refptr<webrtc::NV12Buffer> VulkanGraphicsDevice::ConvertRGBToNV12(ITexture2D* tex)
+    {
+        const int32_t width = static_cast<int32_t>(tex->GetWidth());
+        const int32_t height = static_cast<int32_t>(tex->GetHeight());
+
+        rtc::scoped_refptr<webrtc::NV12Buffer> nv12Buffer = m_frameBufferPool.CreateNV12Buffer(width, height);
+        auto convert = [&](const uint8_t* data, int32_t stride)
+        {
+            libyuv::ARGBToNV12(
+                data,
+                stride,
+                nv12Buffer->MutableDataY(),
+                nv12Buffer->StrideY(),
+                nv12Buffer->MutableDataUV(),
+                nv12Buffer->StrideUV(),
+                width,
+                height);
+        };
+        if (!ReadPixels(tex, convert))
+            return nullptr;
+        return nv12Buffer;
+    }
+
     std::unique_ptr<GpuMemoryBufferHandle> VulkanGraphicsDevice::Map(ITexture2D* texture)
     {
 #if CUDA_PLATFORM
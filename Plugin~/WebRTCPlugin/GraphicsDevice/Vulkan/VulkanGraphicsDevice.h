@@ -58,6 +58,7 @@ namespace webrtc
         bool ResetSync(const ITexture2D* texture) override;
         bool WaitIdleForTest() override;
         rtc::scoped_refptr<I420Buffer> ConvertRGBToI420(ITexture2D* tex) override;
+        rtc::scoped_refptr<NV12Buffer> ConvertRGBToNV12(ITexture2D* tex) override;
 
 #if CUDA_PLATFORM
         bool IsCudaSupport() override { return m_isCudaSupport; }
@@ -66,6 +67,7 @@ namespace webrtc
 #endif
     private:
         VkResult CreateCommandPool();
+        bool ReadPixels(ITexture2D* tex, const ReadPixelsCallback& callback);
         static void AccessQueueCallback(int eventID, void* data);
         static VulkanGraphicsDevice* m_graphicsInstance;
         UnityGraphicsVulkan* m_unityVulkan;
@@ -19,6 +19,7 @@ namespace webrtc
         , m_fence(nullptr)
         , m_commandBuffer(nullptr)
         , m_textureFormat(VK_FORMAT_B8G8R8A8_UNORM)
+        , m_mappedData(nullptr)
     {
     }
 
@@ -26,6 +27,8 @@ namespace webrtc
 
     void VulkanTexture2D::Shutdown()
     {
+        if (m_mappedData)
+            vkUnmapMemory(m_device, m_textureImageMemory);
         if (m_textureImage)
             vkDestroyImage(m_device, m_textureImage, m_allocator);
         if (m_textureImageMemory)
@@ -38,6 +41,7 @@ namespace webrtc
         m_textureImage = nullptr;
         m_textureImageMemory = nullptr;
         m_textureImageMemorySize = 0;
+        m_mappedData = nullptr;
         m_device = nullptr;
         m_commandPool = nullptr;
     }
@@ -155,6 +159,15 @@ namespace webrtc
         m_textureImage = m_unityVulkanImage.image;
         m_textureImageMemory = m_unityVulkanImage.memory.memory;
         m_textureImageMemorySize = m_unityVulkanImage.memory.size;
+
+        // Map the memory persistently. The memory is host coherent, so no need to invalidate before reading.
+        result = vkMapMemory(m_device, m_textureImageMemory, 0, VK_WHOLE_SIZE, 0, &m_mappedData);
+        if (result != VK_SUCCESS)
+        {
+            RTC_LOG(LS_INFO) << "vkMapMemory failed. result:" << result;
+            m_mappedData = nullptr;
+            return false;
+        }
         return true;
     }
 } // end namespace webrtc
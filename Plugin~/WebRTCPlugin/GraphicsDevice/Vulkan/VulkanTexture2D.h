@@ -30,6 +30,9 @@ namespace webrtc
         inline VkDeviceSize GetTextureImageMemorySize() const;
         inline VkFormat GetTextureFormat() const;
 
+        // The host-visible memory of the texture for CPU readback, which is mapped while the texture is alive.
+        const uint8_t* GetMappedData() const { return static_cast<const uint8_t*>(m_mappedData); }
+
         VkFence GetFence() const { return m_fence; }
         VkCommandBuffer GetCommandBuffer() const { return m_commandBuffer; }
 
@@ -43,6 +46,7 @@ namespace webrtc
         VkFence m_fence;
         VkCommandBuffer m_commandBuffer;
         VkFormat m_textureFormat;
+        void* m_mappedData;
         UnityVulkanImage m_unityVulkanImage;
         const VkAllocationCallbacks* m_allocator = nullptr;
     };
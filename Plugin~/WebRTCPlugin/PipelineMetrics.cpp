@@ -0,0 +1,258 @@
+#include "pch.h"
+
+#include <cmath>
+#include <functional>
+#include <sstream>
+
+#include <rtc_base/time_utils.h>
+
+#include "PipelineMetrics.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    const char* PipelineStageName(PipelineStage stage)
+    {
+        switch (stage)
+        {
+        case PipelineStage::kCaptureCopy:
+            return "capture_copy";
+        case PipelineStage::kQueueWait:
+            return "queue_wait";
+        case PipelineStage::kToI420:
+            return "to_i420";
+        case PipelineStage::kEncode:
+            return "encode";
+        case PipelineStage::kPacketize:
+            return "packetize";
+        case PipelineStage::kDecode:
+            return "decode";
+        case PipelineStage::kRenderConvert:
+            return "render_convert";
+        case PipelineStage::kCount:
+            break;
+        }
+        return "unknown";
+    }
+
+    LatencyHistogram::LatencyHistogram()
+        : sumUs_(0)
+        , maxUs_(0)
+    {
+        for (auto& bucket : buckets_)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+
+    size_t LatencyHistogram::BucketIndex(uint64_t value)
+    {
+        // The values below the sub bucket count have their own buckets. The larger values share the bucket with the
+        // values of the same top |kSubBucketBits + 1| bits.
+        if (value < kSubBucketCount)
+            return static_cast<size_t>(value);
+        value = std::min<uint64_t>(value, (uint64_t(1) << kMaxExponent) - 1);
+        int exponent = 0;
+        while ((value >> (exponent + 1)) != 0)
+            exponent++;
+        const int shift = exponent - kSubBucketBits;
+        const uint64_t subBucket = (value >> shift) - kSubBucketCount;
+        return static_cast<size_t>(kSubBucketCount * (shift + 1) + subBucket);
+    }
+
+    uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+    {
+        if (index < kSubBucketCount)
+            return index;
+        const int shift = static_cast<int>(index / kSubBucketCount) - 1;
+        const uint64_t subBucket = index % kSubBucketCount;
+        return ((kSubBucketCount + subBucket + 1) << shift) - 1;
+    }
+
+    void LatencyHistogram::Record(int64_t latencyUs)
+    {
+        const uint64_t value = static_cast<uint64_t>(std::max<int64_t>(latencyUs, 0));
+        buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        sumUs_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t max = maxUs_.load(std::memory_order_relaxed);
+        while (value > max && !maxUs_.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const
+    {
+        // The fields are read separately, so the snapshot which is taken while recording may be slightly skewed.
+        Snapshot snapshot;
+        snapshot.buckets.resize(kBucketCount);
+        snapshot.count = 0;
+        for (size_t i = 0; i < kBucketCount; i++)
+        {
+            snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+            snapshot.count += snapshot.buckets[i];
+        }
+        snapshot.sumUs = sumUs_.load(std::memory_order_relaxed);
+        snapshot.maxUs = maxUs_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    void LatencyHistogram::Reset()
+    {
+        for (auto& bucket : buckets_)
+            bucket.store(0, std::memory_order_relaxed);
+        sumUs_.store(0, std::memory_order_relaxed);
+        maxUs_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t LatencyHistogram::Snapshot::PercentileUs(double percentile) const
+    {
+        if (count == 0)
+            return 0;
+        const double rank = std::ceil(static_cast<double>(count) * std::min(std::max(percentile, 0.0), 100.0) / 100);
+        const uint64_t target = std::max<uint64_t>(static_cast<uint64_t>(rank), 1);
+        uint64_t accumulated = 0;
+        for (size_t i = 0; i < buckets.size(); i++)
+        {
+            accumulated += buckets[i];
+            if (accumulated >= target)
+                return std::min(BucketUpperBound(i), maxUs);
+        }
+        return maxUs;
+    }
+
+    TrackMetrics::TrackMetrics(std::string label, std::string trackId)
+        : label_(std::move(label))
+        , trackId_(std::move(trackId))
+    {
+    }
+
+    std::string TrackMetrics::trackId() const
+    {
+        std::lock_guard<std::mutex> lock(trackIdMutex_);
+        return trackId_;
+    }
+
+    void TrackMetrics::SetTrackId(const std::string& trackId)
+    {
+        std::lock_guard<std::mutex> lock(trackIdMutex_);
+        if (trackId_ != trackId)
+            trackId_ = trackId;
+    }
+
+    void TrackMetrics::Record(PipelineStage stage, int64_t latencyUs)
+    {
+        RTC_DCHECK_LT(static_cast<size_t>(stage), histograms_.size());
+        histograms_[static_cast<size_t>(stage)].Record(latencyUs);
+    }
+
+    void TrackMetrics::Reset()
+    {
+        for (auto& histogram : histograms_)
+            histogram.Reset();
+    }
+
+    ScopedLatency::ScopedLatency(TrackMetrics* metrics, PipelineStage stage)
+        : metrics_(metrics)
+        , stage_(stage)
+        , startUs_(metrics ? rtc::TimeMicros() : 0)
+    {
+    }
+
+    ScopedLatency::~ScopedLatency()
+    {
+        if (metrics_)
+            metrics_->Record(stage_, rtc::TimeMicros() - startUs_);
+    }
+
+    MetricsRegistry& MetricsRegistry::GetInstance()
+    {
+        static MetricsRegistry instance;
+        return instance;
+    }
+
+    std::shared_ptr<TrackMetrics> MetricsRegistry::Register(const std::string& kind, const std::string& trackId)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto metrics = std::make_shared<TrackMetrics>(kind + "/" + std::to_string(nextId_++), trackId);
+
+        // Drop the metrics of the destroyed components.
+        auto expired = [](const std::weak_ptr<TrackMetrics>& track) { return track.expired(); };
+        tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(), expired), tracks_.end());
+        tracks_.push_back(metrics);
+        return metrics;
+    }
+
+    std::vector<std::shared_ptr<TrackMetrics>> MetricsRegistry::LockTracks()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::shared_ptr<TrackMetrics>> tracks;
+        for (const auto& track : tracks_)
+        {
+            if (auto locked = track.lock())
+                tracks.push_back(std::move(locked));
+        }
+        return tracks;
+    }
+
+    std::vector<MetricsRegistry::TrackSnapshot> MetricsRegistry::GetSnapshot()
+    {
+        std::vector<TrackSnapshot> snapshot;
+        for (const auto& track : LockTracks())
+        {
+            TrackSnapshot trackSnapshot;
+            trackSnapshot.label = track->label();
+            trackSnapshot.trackId = track->trackId();
+            for (size_t i = 0; i < trackSnapshot.stages.size(); i++)
+                trackSnapshot.stages[i] = track->histogram(static_cast<PipelineStage>(i)).GetSnapshot();
+            snapshot.push_back(std::move(trackSnapshot));
+        }
+        return snapshot;
+    }
+
+    void MetricsRegistry::Reset()
+    {
+        for (const auto& track : LockTracks())
+            track->Reset();
+    }
+
+    std::string MetricsRegistry::ToText(const std::vector<TrackSnapshot>& snapshot)
+    {
+        const double kQuantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+        using StageFunction = std::function<void(const std::string&, const LatencyHistogram::Snapshot&)>;
+        auto forEachStage = [&snapshot](const StageFunction& f) {
+            for (const TrackSnapshot& track : snapshot)
+            {
+                for (size_t i = 0; i < track.stages.size(); i++)
+                {
+                    if (track.stages[i].count == 0)
+                        continue;
+                    const char* stage = PipelineStageName(static_cast<PipelineStage>(i));
+                    f("track=\"" + track.trackId + "\",component=\"" + track.label + "\",stage=\"" + stage + "\"",
+                      track.stages[i]);
+                }
+            }
+        };
+
+        std::ostringstream out;
+        out << "# HELP webrtc_pipeline_latency_us The latency of the stage of the video pipeline in microseconds.\n";
+        out << "# TYPE webrtc_pipeline_latency_us summary\n";
+        forEachStage([&](const std::string& labels, const LatencyHistogram::Snapshot& stage) {
+            for (double quantile : kQuantiles)
+            {
+                out << "webrtc_pipeline_latency_us{" << labels << ",quantile=\"" << quantile << "\"} "
+                    << stage.PercentileUs(quantile * 100) << "\n";
+            }
+            out << "webrtc_pipeline_latency_us_sum{" << labels << "} " << stage.sumUs << "\n";
+            out << "webrtc_pipeline_latency_us_count{" << labels << "} " << stage.count << "\n";
+        });
+
+        out << "# HELP webrtc_pipeline_latency_max_us The maximum latency of the stage in microseconds.\n";
+        out << "# TYPE webrtc_pipeline_latency_max_us gauge\n";
+        forEachStage([&](const std::string& labels, const LatencyHistogram::Snapshot& stage) {
+            out << "webrtc_pipeline_latency_max_us{" << labels << "} " << stage.maxUs << "\n";
+        });
+        return out.str();
+    }
+} // end namespace webrtc
+} // end namespace unity
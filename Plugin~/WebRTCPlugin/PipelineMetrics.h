@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace unity
+{
+namespace webrtc
+{
+    // The stages of the video pipeline whose latencies are recorded.
+    enum class PipelineStage : uint32_t
+    {
+        // Copying the texture into the buffer of the frame on the render thread.
+        kCaptureCopy = 0,
+        // From the capture until the source passes the frame to WebRTC.
+        kQueueWait,
+        // Converting the frame to I420 for the software encoder.
+        kToI420,
+        kEncode,
+        // Passing the encoded image to WebRTC, which packetizes it synchronously.
+        kPacketize,
+        kDecode,
+        // Converting the decoded frame for the texture of Unity.
+        kRenderConvert,
+        kCount,
+    };
+
+    const char* PipelineStageName(PipelineStage stage);
+
+    // The histogram of the latencies in microseconds. The buckets are log-linear like HdrHistogram, so the error of
+    // the percentiles is within 1/16 of the value. Record takes no lock and may be called on any thread.
+    class LatencyHistogram
+    {
+    public:
+        static constexpr int kSubBucketBits = 4;
+        static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+        // The latencies longer than 2^36 microseconds (about 19 hours) are clamped.
+        static constexpr int kMaxExponent = 36;
+        static constexpr size_t kBucketCount = kSubBucketCount * (kMaxExponent - kSubBucketBits + 1);
+
+        struct Snapshot
+        {
+            uint64_t count = 0;
+            uint64_t sumUs = 0;
+            uint64_t maxUs = 0;
+            std::vector<uint64_t> buckets;
+
+            double MeanUs() const { return count ? static_cast<double>(sumUs) / static_cast<double>(count) : 0; }
+            // Returns the upper bound of the bucket which contains the percentile, which is at most |maxUs|.
+            uint64_t PercentileUs(double percentile) const;
+        };
+
+        LatencyHistogram();
+
+        void Record(int64_t latencyUs);
+        Snapshot GetSnapshot() const;
+        void Reset();
+
+        static size_t BucketIndex(uint64_t value);
+        static uint64_t BucketUpperBound(size_t index);
+
+    private:
+        std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+        std::atomic<uint64_t> sumUs_;
+        std::atomic<uint64_t> maxUs_;
+    };
+
+    // The histograms of the stages for one pipeline component such as the video source, the encoder, the decoder
+    // and the renderer. The components of the same track share the track id, so its stages can be read together.
+    class TrackMetrics
+    {
+    public:
+        TrackMetrics(std::string label, std::string trackId);
+
+        // The label of the component like "encoder/3", which is unique in the registry.
+        const std::string& label() const { return label_; }
+        // The id of the track which the component processes. Empty until it is known.
+        std::string trackId() const;
+        // May be called on any thread, because the track of the encoder is known only when it receives a frame.
+        void SetTrackId(const std::string& trackId);
+        void Record(PipelineStage stage, int64_t latencyUs);
+        const LatencyHistogram& histogram(PipelineStage stage) const
+        {
+            return histograms_[static_cast<size_t>(stage)];
+        }
+        void Reset();
+
+    private:
+        const std::string label_;
+        mutable std::mutex trackIdMutex_;
+        std::string trackId_;
+        std::array<LatencyHistogram, static_cast<size_t>(PipelineStage::kCount)> histograms_;
+    };
+
+    // Records the time from the construction to the destruction. Does nothing when |metrics| is nullptr.
+    class ScopedLatency
+    {
+    public:
+        ScopedLatency(TrackMetrics* metrics, PipelineStage stage);
+        ~ScopedLatency();
+
+    private:
+        TrackMetrics* const metrics_;
+        const PipelineStage stage_;
+        const int64_t startUs_;
+    };
+
+    // Keeps the metrics of all the pipeline components. The components own their metrics, and the metrics of the
+    // destroyed components disappear from the snapshot.
+    class MetricsRegistry
+    {
+    public:
+        struct TrackSnapshot
+        {
+            std::string label;
+            std::string trackId;
+            std::array<LatencyHistogram::Snapshot, static_cast<size_t>(PipelineStage::kCount)> stages;
+        };
+
+        static MetricsRegistry& GetInstance();
+
+        // Creates the metrics which is labeled like "encoder/3". |trackId| can be set later when it is not known yet.
+        std::shared_ptr<TrackMetrics> Register(const std::string& kind, const std::string& trackId = std::string());
+        std::vector<TrackSnapshot> GetSnapshot();
+        void Reset();
+
+        // Writes the snapshot in the text format of Prometheus, labeled with the track id and the component. The stages
+        // without samples are omitted.
+        static std::string ToText(const std::vector<TrackSnapshot>& snapshot);
+
+    private:
+        std::vector<std::shared_ptr<TrackMetrics>> LockTracks();
+
+        std::mutex mutex_;
+        std::vector<std::weak_ptr<TrackMetrics>> tracks_;
+        uint32_t nextId_ = 0;
+    };
+} // end namespace webrtc
+} // end namespace unity
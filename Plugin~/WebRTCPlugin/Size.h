@@ -39,5 +39,45 @@ namespace webrtc
 
     inline bool operator!=(const Size& lhs, const Size& rhs) { return !(lhs == rhs); }
 
+    class Rect
+    {
+    public:
+        constexpr Rect()
+            : x_(0)
+            , y_(0)
+        {
+        }
+        constexpr Rect(int x, int y, int width, int height)
+            : x_(x)
+            , y_(y)
+            , size_(width, height)
+        {
+        }
+        constexpr Rect(const Size& size)
+            : x_(0)
+            , y_(0)
+            , size_(size)
+        {
+        }
+
+        constexpr int x() const { return x_; }
+        constexpr int y() const { return y_; }
+        constexpr int width() const { return size_.width(); }
+        constexpr int height() const { return size_.height(); }
+        constexpr const Size& size() const { return size_; }
+
+    private:
+        int x_;
+        int y_;
+        Size size_;
+    };
+
+    inline bool operator==(const Rect& lhs, const Rect& rhs)
+    {
+        return lhs.x() == rhs.x() && lhs.y() == rhs.y() && lhs.size() == rhs.size();
+    }
+
+    inline bool operator!=(const Rect& lhs, const Rect& rhs) { return !(lhs == rhs); }
+
 }
 }
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace unity
+{
+namespace webrtc
+{
+    // Fixed-capacity ring buffer for one producer thread and one consumer thread. The indices are increased
+    // monotonically and published with acquire/release ordering, so neither side takes a lock or waits.
+    // Reset must not be called while the other thread accesses the buffer.
+    template<typename T>
+    class SpscRingBuffer
+    {
+    public:
+        SpscRingBuffer() = default;
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+        // Discards the elements and reallocates the buffer which can hold at least |capacity| elements.
+        void Reset(size_t capacity)
+        {
+            size_t size = 1;
+            while (size < capacity)
+                size <<= 1;
+            buffer_.assign(size, T());
+            mask_ = size - 1;
+            readIndex_.store(0, std::memory_order_relaxed);
+            writeIndex_.store(0, std::memory_order_relaxed);
+        }
+
+        size_t Capacity() const { return buffer_.size(); }
+
+        // The number of elements which can be read. It is exact on the consumer thread.
+        size_t Size() const
+        {
+            return writeIndex_.load(std::memory_order_acquire) - readIndex_.load(std::memory_order_acquire);
+        }
+
+        // Called on the producer thread. |writer(dest, offset, count)| fills |count| elements at |dest|, which are
+        // the elements from |offset| of the |count| elements to write. Returns the number of written elements,
+        // which is smaller than |count| when the buffer is full.
+        template<typename Writer>
+        size_t Write(size_t count, Writer&& writer)
+        {
+            const size_t write = writeIndex_.load(std::memory_order_relaxed);
+            const size_t read = readIndex_.load(std::memory_order_acquire);
+            count = std::min(count, Capacity() - (write - read));
+            if (count == 0)
+                return 0;
+
+            const size_t start = write & mask_;
+            const size_t first = std::min(count, Capacity() - start);
+            writer(buffer_.data() + start, 0, first);
+            if (first < count)
+                writer(buffer_.data(), first, count - first);
+            writeIndex_.store(write + count, std::memory_order_release);
+            return count;
+        }
+
+        size_t Write(const T* src, size_t count)
+        {
+            return Write(
+                count, [src](T* dest, size_t offset, size_t n) { std::copy(src + offset, src + offset + n, dest); });
+        }
+
+        // Called on the consumer thread. |reader(src, offset, count)| consumes |count| elements at |src|, which are
+        // the elements from |offset| of the |count| elements to read. Returns the number of read elements.
+        template<typename Reader>
+        size_t Read(size_t count, Reader&& reader)
+        {
+            const size_t read = readIndex_.load(std::memory_order_relaxed);
+            const size_t write = writeIndex_.load(std::memory_order_acquire);
+            count = std::min(count, write - read);
+            if (count == 0)
+                return 0;
+
+            const size_t start = read & mask_;
+            const size_t first = std::min(count, Capacity() - start);
+            reader(static_cast<const T*>(buffer_.data() + start), 0, first);
+            if (first < count)
+                reader(static_cast<const T*>(buffer_.data()), first, count - first);
+            readIndex_.store(read + count, std::memory_order_release);
+            return count;
+        }
+
+        size_t Read(T* dest, size_t count)
+        {
+            return Read(
+                count, [dest](const T* src, size_t offset, size_t n) { std::copy(src, src + n, dest + offset); });
+        }
+
+        // Called on the consumer thread. Drops up to |count| elements without reading them.
+        size_t Skip(size_t count)
+        {
+            const size_t read = readIndex_.load(std::memory_order_relaxed);
+            const size_t write = writeIndex_.load(std::memory_order_acquire);
+            count = std::min(count, write - read);
+            readIndex_.store(read + count, std::memory_order_release);
+            return count;
+        }
+
+    private:
+        std::vector<T> buffer_;
+        size_t mask_ = 0;
+        std::atomic<size_t> readIndex_ { 0 };
+        std::atomic<size_t> writeIndex_ { 0 };
+    };
+} // end namespace webrtc
+} // end namespace unity
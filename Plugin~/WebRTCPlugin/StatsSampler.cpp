@@ -0,0 +1,205 @@
+#include "pch.h"
+
+#include "StatsSampler.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        bool GetNumericValue(const RTCStatsMemberInterface& member, double* value)
+        {
+            switch (member.type())
+            {
+            case RTCStatsMemberInterface::kInt32:
+                *value = *member.cast_to<RTCStatsMember<int32_t>>();
+                return true;
+            case RTCStatsMemberInterface::kUint32:
+                *value = *member.cast_to<RTCStatsMember<uint32_t>>();
+                return true;
+            case RTCStatsMemberInterface::kInt64:
+                *value = static_cast<double>(*member.cast_to<RTCStatsMember<int64_t>>());
+                return true;
+            case RTCStatsMemberInterface::kUint64:
+                *value = static_cast<double>(*member.cast_to<RTCStatsMember<uint64_t>>());
+                return true;
+            case RTCStatsMemberInterface::kDouble:
+                *value = *member.cast_to<RTCStatsMember<double>>();
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
+    StatsSampleBuffer::StatsSampleBuffer(size_t capacity)
+        : droppedCount_(0)
+        , readCount_(0)
+        , consumedCount_(0)
+        , writeCount_(0)
+    {
+        samples_.Reset(capacity);
+    }
+
+    const char* StatsSampleBuffer::AcquireString(const std::string& str)
+    {
+        CollectStrings();
+        auto it = strings_.emplace(str, StringEntry()).first;
+        it->second.refCount++;
+        return it->first.c_str();
+    }
+
+    void StatsSampleBuffer::ReleaseString(const char* str)
+    {
+        auto it = strings_.find(str);
+        RTC_DCHECK(it != strings_.end() && it->second.refCount > 0);
+        if (it == strings_.end() || --it->second.refCount > 0)
+            return;
+        it->second.releasedAt = writeCount_;
+        releasedStrings_.emplace_back(writeCount_, it->first);
+        CollectStrings();
+    }
+
+    void StatsSampleBuffer::CollectStrings()
+    {
+        const uint64_t consumed = consumedCount_.load(std::memory_order_acquire);
+        while (!releasedStrings_.empty() && releasedStrings_.front().first <= consumed)
+        {
+            auto it = strings_.find(releasedStrings_.front().second);
+            // The string which has been acquired again, or released again later, is kept for now.
+            if (it != strings_.end() && it->second.refCount == 0 && it->second.releasedAt <= consumed)
+                strings_.erase(it);
+            releasedStrings_.pop_front();
+        }
+    }
+
+    void StatsSampleBuffer::Push(
+        const PeerConnectionObject* connection,
+        const char* statsId,
+        const char* member,
+        int64_t timestampUs,
+        double value,
+        double delta)
+    {
+        const StatsSample sample = { connection, statsId, member, timestampUs, value, delta };
+        if (samples_.Write(&sample, 1) == 0)
+        {
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        writeCount_++;
+    }
+
+    size_t StatsSampleBuffer::Read(StatsSample* samples, size_t maxCount)
+    {
+        // The samples returned by the previous call are not used any longer, so their strings can be freed.
+        consumedCount_.store(readCount_, std::memory_order_release);
+        const size_t count = samples_.Read(samples, maxCount);
+        readCount_ += count;
+        return count;
+    }
+
+    // Delivers the report to the sampler unless the sampler has been destroyed.
+    class StatsSampler::Callback : public RTCStatsCollectorCallback
+    {
+    public:
+        Callback(StatsSampler* sampler, rtc::scoped_refptr<PendingTaskSafetyFlag> safety)
+            : sampler_(sampler)
+            , safety_(std::move(safety))
+        {
+        }
+
+        void OnStatsDelivered(const rtc::scoped_refptr<const RTCStatsReport>& report) override
+        {
+            if (safety_->alive())
+                sampler_->ProcessReport(*report);
+        }
+
+    private:
+        StatsSampler* const sampler_;
+        const rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
+    };
+
+    StatsSampler::StatsSampler(
+        const PeerConnectionObject* owner,
+        PeerConnectionInterface* connection,
+        rtc::Thread* signalingThread,
+        StatsSampleBuffer* buffer)
+        : owner_(owner)
+        , connection_(connection)
+        , signalingThread_(signalingThread)
+        , buffer_(buffer)
+        , safety_(PendingTaskSafetyFlag::CreateDetached())
+    {
+    }
+
+    StatsSampler::~StatsSampler()
+    {
+        signalingThread_->BlockingCall([this]() {
+            task_.Stop();
+            safety_->SetNotAlive();
+            for (const auto& pair : previous_)
+                buffer_->ReleaseString(pair.second.statsId);
+        });
+    }
+
+    void StatsSampler::Start(TimeDelta interval)
+    {
+        signalingThread_->BlockingCall([this, interval]() {
+            task_.Stop();
+            task_ = RepeatingTaskHandle::Start(signalingThread_, [this, interval]() {
+                connection_->GetStats(rtc::make_ref_counted<Callback>(this, safety_).get());
+                return interval;
+            });
+        });
+    }
+
+    void StatsSampler::ProcessReport(const RTCStatsReport& report)
+    {
+        // The stats which are not in the report any longer are forgotten, and their ids are released.
+        std::unordered_map<std::string, Values> current;
+        for (const RTCStats& stats : report)
+        {
+            Values& values = current[stats.id()];
+            auto previous = previous_.find(stats.id());
+            if (previous != previous_.end())
+            {
+                values.statsId = previous->second.statsId;
+                previous->second.statsId = nullptr;
+            }
+            else
+            {
+                values.statsId = buffer_->AcquireString(stats.id());
+            }
+            for (const RTCStatsMemberInterface* member : stats.Members())
+            {
+                double value;
+                if (!member->is_defined() || !GetNumericValue(*member, &value))
+                    continue;
+                values.members[member->name()] = value;
+
+                double delta = 0;
+                if (previous != previous_.end())
+                {
+                    auto it = previous->second.members.find(member->name());
+                    if (it != previous->second.members.end())
+                    {
+                        if (it->second == value)
+                            continue;
+                        delta = value - it->second;
+                    }
+                }
+                // The names of the members are the string literals in libwebrtc.
+                buffer_->Push(owner_, values.statsId, member->name(), stats.timestamp_us(), value, delta);
+            }
+        }
+        for (const auto& pair : previous_)
+        {
+            if (pair.second.statsId)
+                buffer_->ReleaseString(pair.second.statsId);
+        }
+        previous_ = std::move(current);
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <deque>
+#include <unordered_map>
+
+#include <api/peer_connection_interface.h>
+#include <api/task_queue/pending_task_safety_flag.h>
+#include <rtc_base/task_utils/repeating_task.h>
+#include <rtc_base/thread.h>
+
+#include "SpscRingBuffer.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    class PeerConnectionObject;
+
+    // The numeric member of the stats which changed since the previous sample. |member| is the static name of the
+    // member in libwebrtc. |statsId| is owned by StatsSampleBuffer and is shared by all the samples of the stats, so
+    // Unity can cache it by the pointer while the stats are reported. It is freed at the earliest on the next Read after
+    // the stats disappear from the report or the sampler is stopped.
+    struct StatsSample
+    {
+        const PeerConnectionObject* connection;
+        const char* statsId;
+        const char* member;
+        int64_t timestampUs;
+        double value;
+        // The difference from the previous sample. 0 for the first sample of the member.
+        double delta;
+    };
+
+    // The bounded buffer of the samples for all the peer connections of the context. The samplers write on the
+    // signaling thread and Unity reads on the main thread. The samples are dropped when Unity does not read them in
+    // time.
+    class StatsSampleBuffer
+    {
+    public:
+        static constexpr size_t kDefaultCapacity = 16 * 1024;
+
+        explicit StatsSampleBuffer(size_t capacity = kDefaultCapacity);
+
+        // Called on the signaling thread. Returns the shared copy of |str|, which is kept until it is released as
+        // many times as it has been acquired and the samples which refer to it have been read.
+        const char* AcquireString(const std::string& str);
+        void ReleaseString(const char* str);
+
+        // Called on the signaling thread. |statsId| must be acquired and |member| must be static.
+        void Push(
+            const PeerConnectionObject* connection,
+            const char* statsId,
+            const char* member,
+            int64_t timestampUs,
+            double value,
+            double delta);
+
+        // Called on the main thread. Returns the number of the read samples.
+        size_t Read(StatsSample* samples, size_t maxCount);
+
+        uint64_t GetDroppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+
+        // Called on the signaling thread. Returns the number of the strings which have not been freed.
+        size_t GetStringCount() const { return strings_.size(); }
+
+    private:
+        struct StringEntry
+        {
+            int refCount = 0;
+            // The number of the samples written when the string was last released.
+            uint64_t releasedAt = 0;
+        };
+
+        // Frees the released strings which are not referred to by any unread sample.
+        void CollectStrings();
+
+        SpscRingBuffer<StatsSample> samples_;
+        std::atomic<uint64_t> droppedCount_;
+
+        // Accessed only on the main thread.
+        uint64_t readCount_;
+        // The number of the samples returned by the previous calls of Read. Unity does not use them any longer.
+        std::atomic<uint64_t> consumedCount_;
+
+        // Accessed only on the signaling thread. The nodes are never moved, so the pointers to the strings are stable.
+        std::unordered_map<std::string, StringEntry> strings_;
+        std::deque<std::pair<uint64_t, std::string>> releasedStrings_;
+        uint64_t writeCount_;
+    };
+
+    // Collects the stats of the peer connection on the interval, and pushes the numeric members which changed since
+    // the previous report to the buffer.
+    class StatsSampler
+    {
+    public:
+        StatsSampler(
+            const PeerConnectionObject* owner,
+            PeerConnectionInterface* connection,
+            rtc::Thread* signalingThread,
+            StatsSampleBuffer* buffer);
+        ~StatsSampler();
+
+        // Starts collecting the stats, or changes the interval when it has been started.
+        void Start(TimeDelta interval);
+
+        // Called on the signaling thread. Compares |report| with the previous one and pushes the changed members.
+        void ProcessReport(const RTCStatsReport& report);
+
+    private:
+        class Callback;
+
+        const PeerConnectionObject* const owner_;
+        PeerConnectionInterface* const connection_;
+        rtc::Thread* const signalingThread_;
+        StatsSampleBuffer* const buffer_;
+
+        // Accessed only on the signaling thread.
+        RepeatingTaskHandle task_;
+        rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
+        struct Values
+        {
+            // Acquired from the buffer while the stats are in the report.
+            const char* statsId = nullptr;
+            std::unordered_map<std::string, double> members;
+        };
+        // The values of the numeric members in the previous report, keyed by the stats id and the member name.
+        std::unordered_map<std::string, Values> previous_;
+    };
+} // end namespace webrtc
+} // end namespace unity
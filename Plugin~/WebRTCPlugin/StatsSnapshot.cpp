@@ -0,0 +1,173 @@
+#include "pch.h"
+
+#include "StatsSnapshot.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    namespace
+    {
+        template<typename T>
+        void Append(std::vector<uint8_t>& out, T value)
+        {
+            const size_t offset = out.size();
+            out.resize(offset + sizeof(T));
+            std::memcpy(out.data() + offset, &value, sizeof(T));
+        }
+    }
+
+    std::vector<uint8_t> StatsSnapshotWriter::Write(const RTCStatsReport& report, uint32_t typeMask)
+    {
+        body_.clear();
+        stringIndex_.clear();
+        strings_.clear();
+
+        uint32_t count = 0;
+        for (const RTCStats& stats : report)
+        {
+            // The stats of the unknown type are kept unless the filter is given.
+            const uint32_t type = GetStatsType(stats.type());
+            if (type == kUnknownStatsType ? typeMask != kAllStatsTypes : (typeMask & (1u << type)) == 0)
+                continue;
+            WriteStats(stats, type);
+            count++;
+        }
+
+        std::vector<uint8_t> out;
+        size_t stringBytes = 0;
+        for (const std::string* str : strings_)
+            stringBytes += sizeof(uint32_t) + str->size();
+        out.reserve(28 + stringBytes + body_.size());
+
+        Append(out, kMagic);
+        Append(out, kVersion);
+        Append(out, static_cast<uint16_t>(0));
+        Append(out, report.timestamp_us());
+        Append(out, static_cast<uint32_t>(strings_.size()));
+        Append(out, count);
+        for (const std::string* str : strings_)
+        {
+            Append(out, static_cast<uint32_t>(str->size()));
+            out.insert(out.end(), str->begin(), str->end());
+        }
+        out.insert(out.end(), body_.begin(), body_.end());
+        return out;
+    }
+
+    uint32_t StatsSnapshotWriter::Intern(const std::string& str)
+    {
+        auto result = stringIndex_.emplace(str, static_cast<uint32_t>(strings_.size()));
+        if (result.second)
+            strings_.push_back(&result.first->first);
+        return result.first->second;
+    }
+
+    void StatsSnapshotWriter::WriteStats(const RTCStats& stats, uint32_t type)
+    {
+        Put(Intern(stats.id()));
+        Put(type);
+        Put(stats.timestamp_us());
+
+        std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+        Put(static_cast<uint32_t>(members.size()));
+        for (const RTCStatsMemberInterface* member : members)
+            WriteMember(*member);
+    }
+
+    void StatsSnapshotWriter::WriteMember(const RTCStatsMemberInterface& member)
+    {
+        Put(Intern(member.name()));
+        if (!member.is_defined())
+        {
+            Put(static_cast<uint8_t>(member.type() | kUndefinedMember));
+            return;
+        }
+        Put(static_cast<uint8_t>(member.type()));
+
+        switch (member.type())
+        {
+        case RTCStatsMemberInterface::kBool:
+            Put(static_cast<uint8_t>(*member.cast_to<RTCStatsMember<bool>>()));
+            break;
+        case RTCStatsMemberInterface::kInt32:
+            Put(*member.cast_to<RTCStatsMember<int32_t>>());
+            break;
+        case RTCStatsMemberInterface::kUint32:
+            Put(*member.cast_to<RTCStatsMember<uint32_t>>());
+            break;
+        case RTCStatsMemberInterface::kInt64:
+            Put(*member.cast_to<RTCStatsMember<int64_t>>());
+            break;
+        case RTCStatsMemberInterface::kUint64:
+            Put(*member.cast_to<RTCStatsMember<uint64_t>>());
+            break;
+        case RTCStatsMemberInterface::kDouble:
+            Put(*member.cast_to<RTCStatsMember<double>>());
+            break;
+        case RTCStatsMemberInterface::kString:
+            Put(Intern(*member.cast_to<RTCStatsMember<std::string>>()));
+            break;
+        case RTCStatsMemberInterface::kSequenceBool:
+            PutSequence(*member.cast_to<RTCStatsMember<std::vector<bool>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceInt32:
+            PutSequence(*member.cast_to<RTCStatsMember<std::vector<int32_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceUint32:
+            PutSequence(*member.cast_to<RTCStatsMember<std::vector<uint32_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceInt64:
+            PutSequence(*member.cast_to<RTCStatsMember<std::vector<int64_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceUint64:
+            PutSequence(*member.cast_to<RTCStatsMember<std::vector<uint64_t>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceDouble:
+            PutSequence(*member.cast_to<RTCStatsMember<std::vector<double>>>());
+            break;
+        case RTCStatsMemberInterface::kSequenceString:
+            PutSequence(*member.cast_to<RTCStatsMember<std::vector<std::string>>>());
+            break;
+        case RTCStatsMemberInterface::kMapStringUint64:
+            PutMap(*member.cast_to<RTCStatsMember<std::map<std::string, uint64_t>>>());
+            break;
+        case RTCStatsMemberInterface::kMapStringDouble:
+            PutMap(*member.cast_to<RTCStatsMember<std::map<std::string, double>>>());
+            break;
+        }
+    }
+
+    template<typename T>
+    void StatsSnapshotWriter::Put(T value)
+    {
+        Append(body_, value);
+    }
+
+    template<typename T>
+    void StatsSnapshotWriter::PutSequence(const std::vector<T>& values)
+    {
+        Put(static_cast<uint32_t>(values.size()));
+        for (const T& value : values)
+        {
+            if constexpr (std::is_same<T, bool>::value)
+                Put(static_cast<uint8_t>(value));
+            else if constexpr (std::is_same<T, std::string>::value)
+                Put(Intern(value));
+            else
+                Put(value);
+        }
+    }
+
+    template<typename T>
+    void StatsSnapshotWriter::PutMap(const std::map<std::string, T>& values)
+    {
+        Put(static_cast<uint32_t>(values.size()));
+        for (const auto& pair : values)
+        {
+            Put(Intern(pair.first));
+            Put(pair.second);
+        }
+    }
+} // end namespace webrtc
+} // end namespace unity
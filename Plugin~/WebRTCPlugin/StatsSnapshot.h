@@ -0,0 +1,60 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <api/stats/rtc_stats_report.h>
+
+#include "StatsTypes.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    using namespace ::webrtc;
+
+    // Writes the whole stats report into one binary blob, so that Unity decodes it in one pass instead of calling
+    // the getters for each stats object and each member.
+    //
+    // All values are little-endian and not aligned.
+    //   Header:  uint32 magic, uint16 version, uint16 reserved, int64 report timestamp (us),
+    //            uint32 string count, uint32 stats count
+    //   Strings: for each string, uint32 byte length and the UTF-8 bytes without the terminator
+    //   Stats:   for each stats, uint32 id (string index), uint32 type (GetStatsType, kUnknownStatsType if unknown),
+    //            int64 timestamp (us), uint32 member count, and the members
+    //   Member:  uint32 name (string index), uint8 RTCStatsMemberInterface::Type, and the value
+    // The type of the undefined member has kUndefinedMember set and no value follows, so that Unity knows all the
+    // members of the stats. The value is written as:
+    //   bool: uint8, int32/uint32: 4 bytes, int64/uint64/double: 8 bytes, string: uint32 string index,
+    //   sequence: uint32 count and the elements, map: uint32 count and the pairs of the key (string index) and the
+    //   value.
+    class StatsSnapshotWriter
+    {
+    public:
+        static constexpr uint32_t kMagic = 0x42545355; // "USTB"
+        // Version 2 writes the undefined members.
+        static constexpr uint16_t kVersion = 2;
+        static constexpr uint8_t kUndefinedMember = 0x80;
+        // Writes the stats of the types in |typeMask|.
+        std::vector<uint8_t> Write(const RTCStatsReport& report, uint32_t typeMask = kAllStatsTypes);
+
+    private:
+        uint32_t Intern(const std::string& str);
+        void WriteStats(const RTCStats& stats, uint32_t type);
+        void WriteMember(const RTCStatsMemberInterface& member);
+
+        template<typename T>
+        void Put(T value);
+        template<typename T>
+        void PutSequence(const std::vector<T>& values);
+        template<typename T>
+        void PutMap(const std::map<std::string, T>& values);
+
+        std::vector<uint8_t> body_;
+        std::unordered_map<std::string, uint32_t> stringIndex_;
+        std::vector<const std::string*> strings_;
+    };
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+namespace unity
+{
+namespace webrtc
+{
+    // The names of the stats types. The index is the value of RTCStatsType in C#.
+    constexpr std::array<std::string_view, 21> kStatsTypeNames = { "codec",
+                                                                  "inbound-rtp",
+                                                                  "outbound-rtp",
+                                                                  "remote-inbound-rtp",
+                                                                  "remote-outbound-rtp",
+                                                                  "media-source",
+                                                                  "csrc",
+                                                                  "peer-connection",
+                                                                  "data-channel",
+                                                                  "stream",
+                                                                  "track",
+                                                                  "transceiver",
+                                                                  "sender",
+                                                                  "receiver",
+                                                                  "transport",
+                                                                  "sctp-transport",
+                                                                  "candidate-pair",
+                                                                  "local-candidate",
+                                                                  "remote-candidate",
+                                                                  "certificate",
+                                                                  "ice-server" };
+
+    // The type of the stats which is not in |kStatsTypeNames|.
+    constexpr uint32_t kUnknownStatsType = 0xFFFFFFFF;
+
+    // The bit mask of the stats types for filtering. The bit of each type is |1 << type|.
+    constexpr uint32_t kAllStatsTypes = (1u << kStatsTypeNames.size()) - 1;
+
+    namespace stats_types_internal
+    {
+        // FNV-1a
+        constexpr uint32_t Hash(std::string_view str)
+        {
+            uint32_t hash = 2166136261u;
+            for (char c : str)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        // No names collide in the table of this size, so the type is found on the first slot. A collision of the
+        // name which is added later is resolved by the linear probing.
+        constexpr size_t kTableSize = 77;
+        constexpr uint8_t kEmptySlot = 0xFF;
+
+        // The open addressing table from the hash of the name to the type, which is built at compile time.
+        constexpr std::array<uint8_t, kTableSize> BuildTable()
+        {
+            std::array<uint8_t, kTableSize> table {};
+            for (size_t i = 0; i < kTableSize; i++)
+                table[i] = kEmptySlot;
+            for (size_t type = 0; type < kStatsTypeNames.size(); type++)
+            {
+                size_t slot = Hash(kStatsTypeNames[type]) % kTableSize;
+                while (table[slot] != kEmptySlot)
+                    slot = (slot + 1) % kTableSize;
+                table[slot] = static_cast<uint8_t>(type);
+            }
+            return table;
+        }
+
+        constexpr std::array<uint8_t, kTableSize> kTable = BuildTable();
+    }
+
+    // Returns the type of the stats from its name, or kUnknownStatsType.
+    constexpr uint32_t GetStatsType(std::string_view name)
+    {
+        using namespace stats_types_internal;
+        for (size_t slot = Hash(name) % kTableSize; kTable[slot] != kEmptySlot; slot = (slot + 1) % kTableSize)
+        {
+            if (kStatsTypeNames[kTable[slot]] == name)
+                return kTable[slot];
+        }
+        return kUnknownStatsType;
+    }
+
+    static_assert(GetStatsType("codec") == 0, "");
+    static_assert(GetStatsType("outbound-rtp") == 2, "");
+    static_assert(GetStatsType("ice-server") == 20, "");
+    static_assert(GetStatsType("unknown") == kUnknownStatsType, "");
+} // end namespace webrtc
+} // end namespace unity
@@ -32,45 +32,96 @@ namespace webrtc
 
     void UnityAudioTrackSource::RemoveSink(AudioTrackSinkInterface* sink)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto i = std::find(_arrSink.begin(), _arrSink.end(), sink);
+            if (i != _arrSink.end())
+                _arrSink.erase(i);
+        }
 
-        auto i = std::find(_arrSink.begin(), _arrSink.end(), sink);
-        if (i != _arrSink.end())
-            _arrSink.erase(i);
+        // The audio thread may be calling the sink with the snapshot taken before removing.
+        std::lock_guard<std::mutex> lock(_sinkMutex);
     }
 
     void UnityAudioTrackSource::PushAudioData(
         const float* pAudioData, int nSampleRate, size_t nNumChannels, size_t nNumFrames)
+    {
+        // This method is called only on the audio thread of Unity, so the ring buffer and the format don't need the
+        // lock. |_mutex| is only held while taking the snapshot of the sinks.
+        ConvertAudioData(pAudioData, nSampleRate, nNumChannels, nNumFrames);
+        DeliverAudioData();
+    }
+
+    void UnityAudioTrackSource::PushAudioDataBatch(const AudioSourceBatchEntry* entries, size_t count)
+    {
+        // The conversion of one source takes a few microseconds, which is less than waking up other threads, so the
+        // sources are processed on the audio thread of Unity.
+        for (size_t i = 0; i < count; i++)
+        {
+            const AudioSourceBatchEntry& entry = entries[i];
+            if (entry.source == nullptr)
+                continue;
+            entry.source->PushAudioData(
+                entry.audioData,
+                entry.sampleRate,
+                static_cast<size_t>(entry.numberOfChannels),
+                static_cast<size_t>(entry.numberOfFrames));
+        }
+    }
+
+    void UnityAudioTrackSource::ConvertAudioData(
+        const float* pAudioData, int nSampleRate, size_t nNumChannels, size_t nNumFrames)
     {
         RTC_DCHECK(pAudioData);
         RTC_DCHECK(nSampleRate);
         RTC_DCHECK(nNumChannels);
         RTC_DCHECK(nNumFrames);
 
-        std::lock_guard<std::mutex> lock(_mutex);
-
         // eg.  80 for 8KHz and 160 for 16kHz
-        size_t nNumFramesFor10ms = static_cast<size_t>(nSampleRate / 100);
-        size_t nNumSamplesFor10ms = nNumFramesFor10ms * nNumChannels;
-        constexpr size_t nBitPerSample = sizeof(int16_t) * 8;
+        size_t nNumSamplesFor10ms = static_cast<size_t>(nSampleRate / 100) * nNumChannels;
 
         if (_sampleRate != nSampleRate || _numChannels != nNumChannels || _numFrames != nNumFrames)
         {
             _sampleRate = nSampleRate;
             _numChannels = nNumChannels;
             _numFrames = nNumFrames;
-            _convertedAudioData.clear();
-            _convertedAudioData.reserve(nNumSamplesFor10ms * 20);
+            // The remaining samples less than 10ms and the samples of one call.
+            _convertedAudioData.Reset(nNumSamplesFor10ms + nNumFrames);
+            _chunk.resize(nNumSamplesFor10ms);
         }
 
-        for (size_t i = 0; i < nNumFrames; i++)
-            _convertedAudioData.push_back(::webrtc::FloatToS16(pAudioData[i]));
+        // Convert the samples straight into the ring buffer.
+        _convertedAudioData.Write(nNumFrames, [pAudioData](int16_t* dest, size_t offset, size_t count) {
+            ::webrtc::FloatToS16(pAudioData + offset, count, dest);
+        });
+    }
+
+    void UnityAudioTrackSource::DeliverAudioData()
+    {
+        if (_sampleRate == 0)
+            return;
+
+        const size_t nNumFramesFor10ms = static_cast<size_t>(_sampleRate / 100);
+        const size_t nNumSamplesFor10ms = nNumFramesFor10ms * _numChannels;
+        constexpr size_t nBitPerSample = sizeof(int16_t) * 8;
+
+        if (_convertedAudioData.Size() < nNumSamplesFor10ms)
+            return;
+
+        // The snapshot is taken while holding |_sinkMutex|, so RemoveSink cannot return between taking the snapshot
+        // and calling the removed sink.
+        std::lock_guard<std::mutex> sinkLock(_sinkMutex);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _arrSinkSnapshot.assign(_arrSink.begin(), _arrSink.end());
+        }
 
-        while (_convertedAudioData.size() >= nNumSamplesFor10ms)
+        while (_convertedAudioData.Size() >= nNumSamplesFor10ms)
         {
-            for (auto sink : _arrSink)
-                sink->OnData(_convertedAudioData.data(), nBitPerSample, nSampleRate, nNumChannels, nNumFramesFor10ms);
-            _convertedAudioData.erase(_convertedAudioData.begin(), _convertedAudioData.begin() + nNumSamplesFor10ms);
+            _convertedAudioData.Read(_chunk.data(), nNumSamplesFor10ms);
+            for (auto sink : _arrSinkSnapshot)
+                sink->OnData(_chunk.data(), nBitPerSample, _sampleRate, _numChannels, nNumFramesFor10ms);
         }
     }
 
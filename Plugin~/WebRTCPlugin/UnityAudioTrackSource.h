@@ -5,12 +5,26 @@
 #include <api/media_stream_interface.h>
 #include <pc/local_audio_source.h>
 
+#include "SpscRingBuffer.h"
+
 namespace unity
 {
 namespace webrtc
 {
     using namespace ::webrtc;
 
+    class UnityAudioTrackSource;
+
+    // The audio of one source in the batch which is passed from Unity.
+    struct AudioSourceBatchEntry
+    {
+        UnityAudioTrackSource* source;
+        const float* audioData;
+        int32_t sampleRate;
+        int32_t numberOfChannels;
+        int32_t numberOfFrames;
+    };
+
     class UnityAudioTrackSource : public LocalAudioSource
     {
     public:
@@ -23,6 +37,9 @@ namespace webrtc
 
         void PushAudioData(const float* pAudioData, int nSampleRate, size_t nNumChannels, size_t nNumFrames);
 
+        // Pushes the audio of multiple sources in one call, in the order of |entries|.
+        static void PushAudioDataBatch(const AudioSourceBatchEntry* entries, size_t count);
+
     protected:
         UnityAudioTrackSource();
         UnityAudioTrackSource(const cricket::AudioOptions& audio_options);
@@ -30,9 +47,19 @@ namespace webrtc
         ~UnityAudioTrackSource() override;
 
     private:
-        std::vector<int16_t> _convertedAudioData;
+        void ConvertAudioData(const float* pAudioData, int nSampleRate, size_t nNumChannels, size_t nNumFrames);
+        void DeliverAudioData();
+
+        // The converted samples which are not delivered yet. The samples are delivered to the sinks every 10ms.
+        SpscRingBuffer<int16_t> _convertedAudioData;
+        std::vector<int16_t> _chunk;
         std::vector<AudioTrackSinkInterface*> _arrSink;
+        // The copy of |_arrSink| to call the sinks without holding |_mutex|.
+        std::vector<AudioTrackSinkInterface*> _arrSinkSnapshot;
         std::mutex _mutex;
+        // Held while taking the snapshot and calling the sinks, so that RemoveSink waits for the sink which is being
+        // called. Locked before |_mutex|.
+        std::mutex _sinkMutex;
         cricket::AudioOptions _options;
         int _sampleRate = 0;
         size_t _numChannels = 0;
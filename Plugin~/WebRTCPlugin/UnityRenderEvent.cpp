@@ -1,5 +1,6 @@
 #include "pch.h"
 
+#include "ChromeTraceProfiler.h"
 #include "Context.h"
 #include "GpuMemoryBufferPool.h"
 #include "GraphicsDevice/GraphicsDevice.h"
@@ -27,10 +28,10 @@ namespace webrtc
     static Context* s_context = nullptr;
     static std::unique_ptr<UnityProfiler> s_UnityProfiler = nullptr;
     static std::unique_ptr<ProfilerMarkerFactory> s_ProfilerMarkerFactory = nullptr;
+    static ChromeTraceProfiler* s_TraceProfiler = nullptr;
     static std::map<const uint32_t, std::shared_ptr<UnityVideoRenderer>> s_mapVideoRenderer;
     static std::unique_ptr<Clock> s_clock;
 
-    static const size_t kLimitBufferCount = 20;
     static constexpr TimeDelta kStaleFrameLimit = TimeDelta::Seconds(10);
     static const UnityProfilerMarkerDesc* s_MarkerEncode = nullptr;
     static const UnityProfilerMarkerDesc* s_MarkerDecode = nullptr;
@@ -42,6 +43,8 @@ namespace webrtc
 
     ProfilerMarkerFactory* Plugin::ProfilerMarkerFactory() { return s_ProfilerMarkerFactory.get(); }
 
+    ChromeTraceProfiler* Plugin::TraceProfiler() { return s_TraceProfiler; }
+
     static libyuv::FourCC ConvertTextureFormat(UnityRenderingExtTextureFormat type)
     {
         switch (type)
@@ -202,6 +205,14 @@ void PluginLoad(IUnityInterfaces* unityInterfaces)
     }
 #endif
     s_UnityProfiler = UnityProfiler::Get(unityInterfaces);
+    if (!s_UnityProfiler || !s_UnityProfiler->IsAvailable())
+    {
+        // The players which are not the development build have no Unity profiler. The samples are recorded into the
+        // native trace instead while it is started.
+        auto traceProfiler = std::make_unique<ChromeTraceProfiler>();
+        s_TraceProfiler = traceProfiler.get();
+        s_UnityProfiler = std::move(traceProfiler);
+    }
     if (s_UnityProfiler)
     {
         s_ProfilerMarkerFactory = ProfilerMarkerFactory::Create(s_UnityProfiler.get());
@@ -299,15 +310,19 @@ static void UNITY_INTERFACE_API OnBatchUpdateEvent(int eventID, void* data)
             void* ptr = GraphicsUtility::TextureHandleToNativeGraphicsPtr(trackData->texture, device, gfxRenderer);
             unity::webrtc::Size size(trackData->width, trackData->height);
 
-            if (s_bufferPool->bufferCount() < kLimitBufferCount)
-            {
-                std::unique_ptr<const ScopedProfiler> profiler;
-                if (s_ProfilerMarkerFactory)
-                    profiler = s_ProfilerMarkerFactory->CreateScopedProfiler(*s_MarkerEncode);
+            std::unique_ptr<const ScopedProfiler> profiler;
+            if (s_ProfilerMarkerFactory)
+                profiler = s_ProfilerMarkerFactory->CreateScopedProfiler(*s_MarkerEncode);
 
-                auto frame = s_bufferPool->CreateFrame(ptr, size, trackData->format, timestamp);
-                source->OnFrameCaptured(std::move(frame));
+            // The frame is throttled when the source holds too many buffers. The reason is recorded in the pool
+            // for each source.
+            rtc::scoped_refptr<VideoFrame> frame;
+            {
+                ScopedLatency latency(source->metrics(), PipelineStage::kCaptureCopy);
+                frame = s_bufferPool->CreateFrame(ptr, size, trackData->format, timestamp, source);
             }
+            if (frame)
+                source->OnFrameCaptured(std::move(frame));
         }
 #if 0
         else if (trackData->action == VideoStreamTrackAction::Decode)
@@ -32,7 +32,7 @@ namespace webrtc
         bool Configure(const Settings& settings) override
         {
             bool result = decoder_->Configure(settings);
-            if (result && !profilerThread_)
+            if (result && profiler_ && !profilerThread_)
             {
                 std::stringstream ss;
                 ss << "Decoder ";
@@ -37,7 +37,7 @@ namespace webrtc
         int32_t InitEncode(const VideoCodec* codec_settings, int32_t number_of_cores, size_t max_payload_size) override
         {
             int32_t result = encoder_->InitEncode(codec_settings, number_of_cores, max_payload_size);
-            if (result >= WEBRTC_VIDEO_CODEC_OK && !profilerThread_)
+            if (result >= WEBRTC_VIDEO_CODEC_OK && profiler_ && !profilerThread_)
             {
                 std::stringstream ss;
                 ss << "Encoder ";
@@ -54,7 +54,7 @@ namespace webrtc
         int InitEncode(const VideoCodec* codec_settings, const VideoEncoder::Settings& settings) override
         {
             int result = encoder_->InitEncode(codec_settings, settings);
-            if (result >= WEBRTC_VIDEO_CODEC_OK && !profilerThread_)
+            if (result >= WEBRTC_VIDEO_CODEC_OK && profiler_ && !profilerThread_)
             {
                 std::stringstream ss;
                 ss << "Encoder ";
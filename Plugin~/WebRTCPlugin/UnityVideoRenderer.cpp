@@ -15,6 +15,7 @@ namespace webrtc
         , m_timestamp(0)
         , m_callback(callback)
         , m_needFlipVertical(needFlipVertical)
+        , m_metrics(MetricsRegistry::GetInstance().Register("renderer"))
     {
         DebugLog("Create UnityVideoRenderer Id:%d", id);
     }
@@ -76,6 +77,7 @@ namespace webrtc
 
     void* UnityVideoRenderer::ConvertVideoFrameToTextureAndWriteToBuffer(int width, int height, libyuv::FourCC format)
     {
+        ScopedLatency latency(m_metrics.get(), PipelineStage::kRenderConvert);
         auto frame = GetFrameBuffer();
 
         size_t size = static_cast<size_t>(width * height * 4);
@@ -6,6 +6,7 @@
 #include <api/video/video_sink_interface.h>
 #include <third_party/libyuv/include/libyuv.h>
 
+#include "PipelineMetrics.h"
 #include "WebRTCPlugin.h"
 
 namespace unity
@@ -30,6 +31,8 @@ namespace webrtc
         // called on RenderThread
         void* ConvertVideoFrameToTextureAndWriteToBuffer(int width, int height, libyuv::FourCC format);
 
+        TrackMetrics* metrics() const { return m_metrics.get(); }
+
     private:
         uint32_t m_id;
         std::mutex m_mutex;
@@ -39,6 +42,7 @@ namespace webrtc
         std::atomic<int64_t> m_timestamp;
         DelegateVideoFrameResize m_callback;
         bool m_needFlipVertical;
+        std::shared_ptr<TrackMetrics> m_metrics;
     };
 
 } // end namespace webrtc
@@ -20,6 +20,7 @@ namespace webrtc
         : AdaptedVideoTrackSource(/*required_alignment=*/1)
         , is_screencast_(is_screencast)
         , frame_(nullptr)
+        , metrics_(MetricsRegistry::GetInstance().Register("source"))
     {
         taskQueue_ = std::make_unique<rtc::TaskQueue>(
             taskQueueFactory->CreateTaskQueue("VideoFrameScheduler", TaskQueueFactory::Priority::NORMAL));
@@ -71,11 +72,28 @@ namespace webrtc
         }
 
         const webrtc::TimeDelta timestamp = frame_->timestamp();
+        metrics_->Record(PipelineStage::kQueueWait, now_us - timestamp.us());
         rtc::scoped_refptr<VideoFrameAdapter> frame_adapter(
-            new rtc::RefCountedObject<VideoFrameAdapter>(std::move(frame_)));
+            new rtc::RefCountedObject<VideoFrameAdapter>(std::move(frame_), metrics_));
+
+        // The crop rectangle and the size are carried by the buffer and applied lazily, so the pixels outside of the
+        // crop rectangle are never converted.
+        rtc::scoped_refptr<::webrtc::VideoFrameBuffer> buffer = frame_adapter;
+        if (frame_adaptation_params.crop_width != orig_width || frame_adaptation_params.crop_height != orig_height ||
+            frame_adaptation_params.scale_to_width != orig_width ||
+            frame_adaptation_params.scale_to_height != orig_height)
+        {
+            buffer = frame_adapter->CropAndScale(
+                frame_adaptation_params.crop_x,
+                frame_adaptation_params.crop_y,
+                frame_adaptation_params.crop_width,
+                frame_adaptation_params.crop_height,
+                frame_adaptation_params.scale_to_width,
+                frame_adaptation_params.scale_to_height);
+        }
 
         ::webrtc::VideoFrame::Builder builder = ::webrtc::VideoFrame::Builder()
-                                                    .set_video_frame_buffer(std::move(frame_adapter))
+                                                    .set_video_frame_buffer(std::move(buffer))
                                                     .set_timestamp_us(timestamp.us());
         OnFrame(builder.build());
     }
@@ -92,8 +110,11 @@ namespace webrtc
     {
         SendFeedback();
 
-        const std::unique_lock<std::mutex> lock(mutex_);
-        frame_ = frame;
+        {
+            const std::unique_lock<std::mutex> lock(mutex_);
+            frame_ = frame;
+        }
+        scheduler_->OnFrameCaptured(frame.get());
     }
 
 } // end namespace webrtc
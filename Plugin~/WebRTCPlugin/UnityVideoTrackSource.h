@@ -8,6 +8,7 @@
 #include <media/base/adapted_video_track_source.h>
 #include <rtc_base/task_queue.h>
 
+#include "PipelineMetrics.h"
 #include "VideoFrame.h"
 
 namespace unity
@@ -46,6 +47,7 @@ namespace webrtc
         bool is_screencast() const override;
         absl::optional<bool> needs_denoising() const override;
         void OnFrameCaptured(rtc::scoped_refptr<VideoFrame> frame);
+        TrackMetrics* metrics() const { return metrics_.get(); }
 
         using VideoTrackSourceInterface::AddOrUpdateSink;
         using VideoTrackSourceInterface::RemoveSink;
@@ -80,6 +82,8 @@ namespace webrtc
         std::unique_ptr<rtc::TaskQueue> taskQueue_;
         std::unique_ptr<VideoFrameScheduler> scheduler_;
         rtc::scoped_refptr<unity::webrtc::VideoFrame> frame_;
+        // Shared with the frames which are passed to WebRTC, which record the conversion.
+        const std::shared_ptr<TrackMetrics> metrics_;
     };
 
 } // end namespace webrtc
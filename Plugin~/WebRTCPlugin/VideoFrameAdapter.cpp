@@ -8,17 +8,6 @@ namespace unity
 {
 namespace webrtc
 {
-    template<typename T>
-    bool Contains(rtc::ArrayView<T> arr, T value)
-    {
-        for (auto e : arr)
-        {
-            if (e == value)
-                return true;
-        }
-        return false;
-    }
-
     ::webrtc::VideoFrame VideoFrameAdapter::CreateVideoFrame(rtc::scoped_refptr<VideoFrame> frame)
     {
         rtc::scoped_refptr<VideoFrameAdapter> adapter(new rtc::RefCountedObject<VideoFrameAdapter>(std::move(frame)));
@@ -26,8 +15,10 @@ namespace webrtc
         return ::webrtc::VideoFrame::Builder().set_video_frame_buffer(adapter).build();
     }
 
-    VideoFrameAdapter::ScaledBuffer::ScaledBuffer(rtc::scoped_refptr<VideoFrameAdapter> parent, int width, int height)
+    VideoFrameAdapter::ScaledBuffer::ScaledBuffer(
+        rtc::scoped_refptr<VideoFrameAdapter> parent, const Rect& crop, int width, int height)
         : parent_(parent)
+        , crop_(crop)
         , width_(width)
         , height_(height)
     {
@@ -39,32 +30,44 @@ namespace webrtc
 
     rtc::scoped_refptr<webrtc::I420BufferInterface> VideoFrameAdapter::ScaledBuffer::ToI420()
     {
-        return parent_->GetOrCreateFrameBufferForSize(Size(width_, height_))->ToI420();
+        auto buffer = parent_->GetOrCreateFrameBufferForSize(crop_, Size(width_, height_));
+        return buffer ? buffer->ToI420() : nullptr;
     }
 
     const I420BufferInterface* VideoFrameAdapter::ScaledBuffer::GetI420() const
     {
-        return parent_->GetOrCreateFrameBufferForSize(Size(width_, height_))->GetI420();
+        auto buffer = parent_->GetOrCreateFrameBufferForSize(crop_, Size(width_, height_));
+        return buffer ? buffer->GetI420() : nullptr;
     }
 
     rtc::scoped_refptr<VideoFrameBuffer>
     VideoFrameAdapter::ScaledBuffer::GetMappedFrameBuffer(rtc::ArrayView<VideoFrameBuffer::Type> types)
     {
-        auto buffer = parent_->GetOrCreateFrameBufferForSize(Size(width_, height_));
-        return Contains(types, buffer->type()) ? buffer : nullptr;
+        for (auto type : types)
+        {
+            if (type != VideoFrameBuffer::Type::kI420 && type != VideoFrameBuffer::Type::kNV12)
+                continue;
+            return parent_->GetOrCreateFrameBufferForSize(crop_, Size(width_, height_), type);
+        }
+        return nullptr;
     }
 
     rtc::scoped_refptr<VideoFrameBuffer> VideoFrameAdapter::ScaledBuffer::CropAndScale(
         int offset_x, int offset_y, int crop_width, int crop_height, int scaled_width, int scaled_height)
     {
-        RTC_DCHECK_NOTREACHED();
-
-        return nullptr;
+        // Map the rectangle on this buffer to the parent frame, so that the pixels are read only once.
+        const Rect crop(
+            crop_.x() + offset_x * crop_.width() / width_,
+            crop_.y() + offset_y * crop_.height() / height_,
+            crop_width * crop_.width() / width_,
+            crop_height * crop_.height() / height_);
+        return rtc::make_ref_counted<ScaledBuffer>(parent_, crop, scaled_width, scaled_height);
     }
 
-    VideoFrameAdapter::VideoFrameAdapter(rtc::scoped_refptr<VideoFrame> frame)
+    VideoFrameAdapter::VideoFrameAdapter(rtc::scoped_refptr<VideoFrame> frame, std::shared_ptr<TrackMetrics> metrics)
         : frame_(std::move(frame))
         , size_(frame_->size())
+        , metrics_(std::move(metrics))
     {
     }
 
@@ -82,38 +85,118 @@ namespace webrtc
 
     const I420BufferInterface* VideoFrameAdapter::GetI420() const
     {
-        return ConvertToVideoFrameBuffer(frame_)->GetI420();
+        // The conversion fails when the texture for CPU readback is not prepared.
+        auto buffer = ConvertToVideoFrameBuffer(frame_);
+        return buffer ? buffer->GetI420() : nullptr;
     }
 
     rtc::scoped_refptr<I420BufferInterface> VideoFrameAdapter::ToI420()
     {
-        return ConvertToVideoFrameBuffer(frame_)->ToI420();
+        auto buffer = ConvertToVideoFrameBuffer(frame_);
+        return buffer ? buffer->ToI420() : nullptr;
+    }
+
+    rtc::scoped_refptr<VideoFrameBuffer>
+    VideoFrameAdapter::GetMappedFrameBuffer(rtc::ArrayView<VideoFrameBuffer::Type> types)
+    {
+        for (auto type : types)
+        {
+            if (type == VideoFrameBuffer::Type::kI420)
+                return ConvertToVideoFrameBuffer(frame_);
+            if (type == VideoFrameBuffer::Type::kNV12)
+                return ConvertToNV12Buffer();
+        }
+        return nullptr;
     }
 
     rtc::scoped_refptr<VideoFrameBuffer> VideoFrameAdapter::CropAndScale(
         int offset_x, int offset_y, int crop_width, int crop_height, int scaled_width, int scaled_height)
     {
         return rtc::make_ref_counted<ScaledBuffer>(
-            rtc::scoped_refptr<VideoFrameAdapter>(this), scaled_width, scaled_height);
+            rtc::scoped_refptr<VideoFrameAdapter>(this),
+            Rect(offset_x, offset_y, crop_width, crop_height),
+            scaled_width,
+            scaled_height);
     }
 
-    rtc::scoped_refptr<VideoFrameBuffer> VideoFrameAdapter::GetOrCreateFrameBufferForSize(const Size& size)
+    rtc::scoped_refptr<VideoFrameBuffer> VideoFrameAdapter::GetOrCreateFrameBufferForSize(
+        const Rect& crop, const Size& size, VideoFrameBuffer::Type type)
     {
         std::unique_lock<std::mutex> guard(scaleLock_);
+        return GetOrCreateFrameBufferForSizeLocked(crop, size, type);
+    }
 
-        for (auto scaledI420buffer : scaledI40Buffers_)
+    rtc::scoped_refptr<VideoFrameBuffer> VideoFrameAdapter::GetOrCreateFrameBufferForSizeLocked(
+        const Rect& crop, const Size& size, VideoFrameBuffer::Type type)
+    {
+        if (crop == Rect(size_) && size == size_)
+            return ConvertToBuffer(type);
+
+        if (auto cached = FindBufferLocked(crop, size, type))
+            return cached;
+
+        // Build the layers as a pyramid. A layer is derived from the layer twice as large only when it is already
+        // cached or the crop rectangle is an exact power of two of the size, so that libyuv takes the fast 2:1 box
+        // filter path. Otherwise the layer is scaled from the base buffer directly, because an unrequested
+        // intermediate layer with a non-2:1 scale costs more and filters worse.
+        rtc::scoped_refptr<VideoFrameBuffer> buffer;
+        const Size doubleSize(size.width() * 2, size.height() * 2);
+        const bool fitsDouble = doubleSize.width() <= crop.width() && doubleSize.height() <= crop.height();
+        rtc::scoped_refptr<VideoFrameBuffer> source = fitsDouble ? FindBufferLocked(crop, doubleSize, type) : nullptr;
+        if (!source && fitsDouble && IsHalvingChain(crop, size))
+        {
+            source = GetOrCreateFrameBufferForSizeLocked(crop, doubleSize, type);
+            if (!source)
+                return nullptr;
+        }
+        if (source)
         {
-            Size bufferSize(scaledI420buffer->width(), scaledI420buffer->height());
-            if (size == bufferSize)
-            {
-                return scaledI420buffer;
-            }
+            buffer = source->Scale(size.width(), size.height());
         }
-        auto buffer = VideoFrameBuffer::CropAndScale(0, 0, width(), height(), size.width(), size.height());
-        scaledI40Buffers_.push_back(buffer);
+        else
+        {
+            // Only the pixels in the crop rectangle are read.
+            auto base = ConvertToBuffer(type);
+            if (!base)
+                return nullptr;
+            buffer = base->CropAndScale(crop.x(), crop.y(), crop.width(), crop.height(), size.width(), size.height());
+        }
+        scaledBuffers_.emplace(
+            ScaledBufferKey(type, crop.x(), crop.y(), crop.width(), crop.height(), size.width(), size.height()),
+            buffer);
         return buffer;
     }
 
+    rtc::scoped_refptr<VideoFrameBuffer>
+    VideoFrameAdapter::FindBufferLocked(const Rect& crop, const Size& size, VideoFrameBuffer::Type type) const
+    {
+        const ScaledBufferKey key(
+            type, crop.x(), crop.y(), crop.width(), crop.height(), size.width(), size.height());
+        auto it = scaledBuffers_.find(key);
+        return it != scaledBuffers_.end() ? it->second : nullptr;
+    }
+
+    bool VideoFrameAdapter::IsHalvingChain(const Rect& crop, const Size& size)
+    {
+        int width = size.width();
+        int height = size.height();
+        if (width <= 0 || height <= 0)
+            return false;
+        while (width < crop.width() && height < crop.height())
+        {
+            width *= 2;
+            height *= 2;
+        }
+        return width == crop.width() && height == crop.height();
+    }
+
+    rtc::scoped_refptr<VideoFrameBuffer> VideoFrameAdapter::ConvertToBuffer(VideoFrameBuffer::Type type)
+    {
+        if (type == VideoFrameBuffer::Type::kNV12)
+            return ConvertToNV12Buffer();
+        return ConvertToVideoFrameBuffer(frame_);
+    }
+
     rtc::scoped_refptr<I420BufferInterface>
     VideoFrameAdapter::ConvertToVideoFrameBuffer(rtc::scoped_refptr<VideoFrame> video_frame) const
     {
@@ -125,9 +208,24 @@ namespace webrtc
         RTC_DCHECK(video_frame->HasGpuMemoryBuffer());
 
         auto gmb = video_frame->GetGpuMemoryBuffer();
+        ScopedLatency latency(metrics_.get(), PipelineStage::kToI420);
         i420Buffer_ = gmb->ToI420();
         return i420Buffer_;
     }
 
+    rtc::scoped_refptr<NV12BufferInterface> VideoFrameAdapter::ConvertToNV12Buffer() const
+    {
+        std::unique_lock<std::mutex> guard(convertLock_);
+        if (nv12Buffer_)
+            return nv12Buffer_;
+
+        RTC_DCHECK(frame_);
+        RTC_DCHECK(frame_->HasGpuMemoryBuffer());
+
+        auto gmb = frame_->GetGpuMemoryBuffer();
+        nv12Buffer_ = gmb->ToNV12();
+        return nv12Buffer_;
+    }
+
 }
 }
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <api/video/video_frame.h>
-#include <vector>
+#include <map>
+#include <tuple>
 
+#include "PipelineMetrics.h"
 #include "VideoFrame.h"
 
 namespace unity
@@ -27,7 +29,8 @@ namespace webrtc
         class ScaledBuffer : public ScalableBufferInterface
         {
         public:
-            ScaledBuffer(rtc::scoped_refptr<VideoFrameAdapter> parent, int width, int height);
+            // |crop| is the rectangle on the parent frame which is scaled to |width| x |height|.
+            ScaledBuffer(rtc::scoped_refptr<VideoFrameAdapter> parent, const Rect& crop, int width, int height);
             ~ScaledBuffer() override;
 
             VideoFrameBuffer::Type type() const override;
@@ -42,6 +45,8 @@ namespace webrtc
             GetMappedFrameBuffer(rtc::ArrayView<webrtc::VideoFrameBuffer::Type> types) override;
 
             rtc::scoped_refptr<VideoFrame> GetVideoFrame() const { return parent_->frame_; }
+            const VideoFrameAdapter* parent() const { return parent_.get(); }
+            const Rect& crop() const { return crop_; }
 
             rtc::scoped_refptr<webrtc::VideoFrameBuffer> CropAndScale(
                 int offset_x, int offset_y, int crop_width, int crop_height, int scaled_width, int scaled_height)
@@ -49,15 +54,20 @@ namespace webrtc
 
         private:
             const rtc::scoped_refptr<VideoFrameAdapter> parent_;
+            const Rect crop_;
             const int width_;
             const int height_;
         };
 
-        explicit VideoFrameAdapter(rtc::scoped_refptr<VideoFrame> frame);
+        // The conversion to I420 is recorded to |metrics| if given.
+        explicit VideoFrameAdapter(
+            rtc::scoped_refptr<VideoFrame> frame, std::shared_ptr<TrackMetrics> metrics = nullptr);
 
         static ::webrtc::VideoFrame CreateVideoFrame(rtc::scoped_refptr<VideoFrame> frame);
 
         rtc::scoped_refptr<VideoFrame> GetVideoFrame() const { return frame_; }
+        // The metrics of the source of the frame, or nullptr.
+        TrackMetrics* metrics() const { return metrics_.get(); }
 
         VideoFrameBuffer::Type type() const override;
         int width() const override { return size_.width(); }
@@ -66,6 +76,11 @@ namespace webrtc
 
         const I420BufferInterface* GetI420() const override;
         rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+        // Converts the frame to the first type in |types| which is supported (kI420 or kNV12), so the encoder can
+        // receive the format which it prefers without the second conversion.
+        rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+        GetMappedFrameBuffer(rtc::ArrayView<webrtc::VideoFrameBuffer::Type> types) override;
         rtc::scoped_refptr<webrtc::VideoFrameBuffer> CropAndScale(
             int offset_x, int offset_y, int crop_width, int crop_height, int scaled_width, int scaled_height) override;
 
@@ -73,15 +88,29 @@ namespace webrtc
         ~VideoFrameAdapter() override { }
 
     private:
-        rtc::scoped_refptr<webrtc::VideoFrameBuffer> GetOrCreateFrameBufferForSize(const Size& size);
+        // The key of the scaled buffers, which is the type, the crop rectangle (x, y, width, height) and the size.
+        using ScaledBufferKey = std::tuple<VideoFrameBuffer::Type, int, int, int, int, int, int>;
+
+        rtc::scoped_refptr<webrtc::VideoFrameBuffer> GetOrCreateFrameBufferForSize(
+            const Rect& crop, const Size& size, VideoFrameBuffer::Type type = VideoFrameBuffer::Type::kI420);
+        rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+        GetOrCreateFrameBufferForSizeLocked(const Rect& crop, const Size& size, VideoFrameBuffer::Type type);
+        rtc::scoped_refptr<webrtc::VideoFrameBuffer>
+        FindBufferLocked(const Rect& crop, const Size& size, VideoFrameBuffer::Type type) const;
+        // Returns true if |crop| is |size| multiplied by a power of two, so that halving it repeatedly yields |size|.
+        static bool IsHalvingChain(const Rect& crop, const Size& size);
+        rtc::scoped_refptr<webrtc::VideoFrameBuffer> ConvertToBuffer(VideoFrameBuffer::Type type);
         rtc::scoped_refptr<I420BufferInterface>
         ConvertToVideoFrameBuffer(rtc::scoped_refptr<VideoFrame> video_frame) const;
+        rtc::scoped_refptr<NV12BufferInterface> ConvertToNV12Buffer() const;
         // todo(kazuki):
         // Need this buffer because the type() method returns kI420.
         mutable rtc::scoped_refptr<I420BufferInterface> i420Buffer_;
-        std::vector<rtc::scoped_refptr<VideoFrameBuffer>> scaledI40Buffers_;
+        mutable rtc::scoped_refptr<NV12BufferInterface> nv12Buffer_;
+        std::map<ScaledBufferKey, rtc::scoped_refptr<VideoFrameBuffer>> scaledBuffers_;
         const rtc::scoped_refptr<VideoFrame> frame_;
         const Size size_;
+        const std::shared_ptr<TrackMetrics> metrics_;
         mutable std::mutex scaleLock_;
         mutable std::mutex convertLock_;
     };
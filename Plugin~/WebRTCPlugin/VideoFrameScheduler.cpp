@@ -11,11 +11,22 @@ namespace webrtc
 {
     constexpr TimeDelta kTimeout = TimeDelta::Millis(1000);
 
+    // Allows the frame arrived slightly earlier than the interval to be delivered without waiting for the timer.
+    constexpr double kMaxTokens = 2.0;
+
+    // Absorbs the rounding of the refill, so that a token is available exactly one interval after the last one.
+    constexpr double kTokenTolerance = 1e-3;
+
     VideoFrameScheduler::VideoFrameScheduler(TaskQueueBase* queue, Clock* clock)
         : maxFramerate_(30)
         , queue_(queue)
         , lastCaptureStartedTime_(Timestamp::Zero())
+        , tokens_(1.0)
+        , lastTokenRefillTime_(Timestamp::Zero())
+        , capturedSinceLastTimer_(false)
+        , framePending_(false)
         , clock_(clock)
+        , safety_(PendingTaskSafetyFlag::CreateDetached())
     {
     }
 
@@ -24,7 +35,9 @@ namespace webrtc
         rtc::Event done;
 
         // Waiting for stopping task.
-        queue_->PostTask([task = std::move(task_), &done]() mutable {
+        queue_->PostTask([this, task = std::move(task_), &done]() mutable {
+            // The frames posted by OnFrameCaptured after this task are dropped.
+            safety_->SetNotAlive();
             task.Stop();
             done.Set();
         });
@@ -35,6 +48,7 @@ namespace webrtc
     {
         callback_ = callback;
         lastCaptureStartedTime_ = clock_->CurrentTime();
+        lastTokenRefillTime_ = lastCaptureStartedTime_;
         StartRepeatingTask();
     }
 
@@ -51,7 +65,19 @@ namespace webrtc
         }
     }
 
-    void VideoFrameScheduler::OnFrameCaptured(const VideoFrame* frame) { }
+    void VideoFrameScheduler::OnFrameCaptured(const VideoFrame* frame)
+    {
+        if (!frame)
+            return;
+
+        // This method is called on the render thread.
+        if (!queue_->IsCurrent())
+        {
+            queue_->PostTask(SafeTask(safety_, [this]() { DeliverCapturedFrame(); }));
+            return;
+        }
+        DeliverCapturedFrame();
+    }
 
     void VideoFrameScheduler::SetMaxFramerateFps(int maxFramerate) { maxFramerate_ = maxFramerate; }
 
@@ -84,6 +110,35 @@ namespace webrtc
         callback_();
     }
 
+    void VideoFrameScheduler::DeliverCapturedFrame()
+    {
+        if (paused_ || !callback_ || maxFramerate_ == 0)
+            return;
+
+        // The frame exceeding the rate is delivered by the timer at the next interval.
+        if (!TryAcquireToken())
+        {
+            framePending_ = true;
+            return;
+        }
+
+        framePending_ = false;
+        capturedSinceLastTimer_ = true;
+        CaptureNextFrame();
+    }
+
+    bool VideoFrameScheduler::TryAcquireToken()
+    {
+        Timestamp now = clock_->CurrentTime();
+        double refill = (now - lastTokenRefillTime_) / TimeDelta::Seconds(1) * maxFramerate_;
+        tokens_ = std::min(tokens_ + refill, kMaxTokens);
+        lastTokenRefillTime_ = now;
+        if (tokens_ < 1.0 - kTokenTolerance)
+            return false;
+        tokens_ = std::max(tokens_ - 1.0, 0.0);
+        return true;
+    }
+
     void VideoFrameScheduler::StartRepeatingTask()
     {
         RTC_DCHECK(!paused_);
@@ -91,9 +146,18 @@ namespace webrtc
 
         auto firstDelay = ScheduleNextFrame();
         RTC_DCHECK(firstDelay);
+        capturedSinceLastTimer_ = false;
 
         task_ = RepeatingTaskHandle::DelayedStart(queue_, firstDelay.value(), [this]() {
-            CaptureNextFrame();
+            // The timer delivers the frame throttled by the token bucket, and is the fallback to repeat the last
+            // frame. When the frame has been delivered by OnFrameCaptured and no frame is pending, the capture is
+            // postponed to one interval after that delivery.
+            if ((framePending_ || !capturedSinceLastTimer_) && TryAcquireToken())
+            {
+                framePending_ = false;
+                CaptureNextFrame();
+            }
+            capturedSinceLastTimer_ = false;
             auto delay = ScheduleNextFrame();
             if (delay.has_value())
                 return delay.value();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <api/task_queue/pending_task_safety_flag.h>
 #include <rtc_base/task_utils/repeating_task.h>
 
 #include "VideoFrame.h"
@@ -25,7 +26,9 @@ namespace webrtc
         virtual void Pause(bool pause);
 
         // Called after |frame| has been captured. |frame| may be set to nullptr
-        // if the capture request failed.
+        // if the capture request failed. The frame is delivered immediately if
+        // the token bucket allows it, otherwise the timer delivers it at the next
+        // interval.
         virtual void OnFrameCaptured(const VideoFrame* frame);
 
         // Called when WebRTC requests the VideoTrackSource to provide frames
@@ -35,6 +38,8 @@ namespace webrtc
     private:
         absl::optional<TimeDelta> ScheduleNextFrame();
         void CaptureNextFrame();
+        void DeliverCapturedFrame();
+        bool TryAcquireToken();
         void StartRepeatingTask();
         void StopTask();
 
@@ -44,7 +49,14 @@ namespace webrtc
         RepeatingTaskHandle task_;
         TaskQueueBase* queue_;
         Timestamp lastCaptureStartedTime_;
+        // The token bucket limits the frames delivered by OnFrameCaptured to |maxFramerate_|.
+        double tokens_;
+        Timestamp lastTokenRefillTime_;
+        bool capturedSinceLastTimer_;
+        // A frame has been throttled by the token bucket and waits for the timer.
+        bool framePending_;
         Clock* clock_;
+        rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
     };
 }
 }
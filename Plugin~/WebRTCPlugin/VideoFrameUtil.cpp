@@ -19,6 +19,8 @@ namespace webrtc
         Size size = Size(static_cast<int>(texture->GetWidth()), static_cast<int>(texture->GetHeight()));
 
         auto buffer = rtc::make_ref_counted<GpuMemoryBufferFromUnity>(device, size, format);
+        buffer->AttachCpuReadTexture(std::unique_ptr<ITexture2D>(
+            device->CreateCPUReadTextureV(texture->GetWidth(), texture->GetHeight(), format)));
 
         if (!buffer->CopyBuffer(ptr))
             return nullptr;
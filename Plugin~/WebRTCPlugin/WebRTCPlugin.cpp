@@ -1,11 +1,13 @@
 #include "pch.h"
 
+#include "ChromeTraceProfiler.h"
 #include "Context.h"
 #include "CreateSessionDescriptionObserver.h"
 #include "EncodedStreamTransformer.h"
 #include "GraphicsDevice/GraphicsUtility.h"
 #include "MediaStreamObserver.h"
 #include "PeerConnectionObject.h"
+#include "PipelineMetrics.h"
 #include "SetLocalDescriptionObserver.h"
 #include "SetRemoteDescriptionObserver.h"
 #include "UnityAudioTrackSource.h"
@@ -271,6 +273,8 @@ extern "C"
     ContextCreateVideoTrack(Context* context, const char* label, webrtc::VideoTrackSourceInterface* source)
     {
         rtc::scoped_refptr<VideoTrackInterface> track = context->CreateVideoTrack(label, source);
+        // The sources of the video tracks are created by ContextCreateVideoTrackSource.
+        static_cast<UnityVideoTrackSource*>(source)->metrics()->SetTrackId(track->id());
         context->AddRefPtr(track);
         return track.get();
     }
@@ -425,6 +429,7 @@ extern "C"
 
     UNITY_INTERFACE_EXPORT void VideoTrackAddOrUpdateSink(VideoTrackInterface* track, UnityVideoRenderer* sink)
     {
+        sink->metrics()->SetTrackId(track->id());
         track->AddOrUpdateSink(sink, rtc::VideoSinkWants());
     }
 
@@ -447,7 +452,7 @@ extern "C"
         }
     }
 
-    UNITY_INTERFACE_EXPORT Context* ContextCreate(int uid)
+    UNITY_INTERFACE_EXPORT Context* ContextCreateWithAudioConfig(int uid, const AudioConfig* audioConfig)
     {
         auto ctx = ContextManager::GetInstance()->GetContext(uid);
         if (ctx != nullptr)
@@ -458,10 +463,22 @@ extern "C"
         ContextDependencies dependencies;
         dependencies.device = Plugin::GraphicsDevice();
         dependencies.profiler = Plugin::ProfilerMarkerFactory();
+        if (audioConfig != nullptr)
+        {
+            if (audioConfig->IsValid())
+                dependencies.audio = *audioConfig;
+            else
+                DebugLog(
+                    "Unsupported audio config (sample rate %d, channels %d) is ignored",
+                    audioConfig->sampleRate,
+                    audioConfig->channels);
+        }
         ctx = ContextManager::GetInstance()->CreateContext(uid, dependencies);
         return ctx;
     }
 
+    UNITY_INTERFACE_EXPORT Context* ContextCreate(int uid) { return ContextCreateWithAudioConfig(uid, nullptr); }
+
     UNITY_INTERFACE_EXPORT void ContextDestroy(int uid) { ContextManager::GetInstance()->DestroyContext(uid); }
 
     UNITY_INTERFACE_EXPORT PeerConnectionObject* ContextCreatePeerConnection(Context* context)
@@ -656,6 +673,126 @@ extern "C"
         return context->GetStatsList(report, length, types);
     }
 
+    UNITY_INTERFACE_EXPORT const RTCStats** ContextGetStatsListFiltered(
+        Context* context, const RTCStatsReport* report, size_t* length, uint32_t** types, uint32_t typeMask)
+    {
+        return context->GetStatsList(report, length, types, typeMask);
+    }
+
+    UNITY_INTERFACE_EXPORT const uint8_t*
+    ContextGetStatsSnapshot(Context* context, const RTCStatsReport* report, size_t* length)
+    {
+        return context->GetStatsSnapshot(report, length);
+    }
+
+    UNITY_INTERFACE_EXPORT const uint8_t* ContextGetStatsSnapshotFiltered(
+        Context* context, const RTCStatsReport* report, size_t* length, uint32_t typeMask)
+    {
+        return context->GetStatsSnapshot(report, length, typeMask);
+    }
+
+    UNITY_INTERFACE_EXPORT void
+    PeerConnectionStartStatsSampler(Context* context, PeerConnectionObject* obj, int32_t intervalMs)
+    {
+        if (intervalMs <= 0)
+        {
+            DebugLog("The interval of the stats sampler must be positive: %d", intervalMs);
+            return;
+        }
+        context->StartStatsSampler(obj, TimeDelta::Millis(intervalMs));
+    }
+
+    UNITY_INTERFACE_EXPORT void PeerConnectionStopStatsSampler(Context* context, PeerConnectionObject* obj)
+    {
+        context->StopStatsSampler(obj);
+    }
+
+    UNITY_INTERFACE_EXPORT int32_t ContextReadStatsSamples(Context* context, StatsSample* samples, int32_t maxCount)
+    {
+        if (samples == nullptr || maxCount <= 0)
+            return 0;
+        return static_cast<int32_t>(context->GetStatsSampleBuffer()->Read(samples, static_cast<size_t>(maxCount)));
+    }
+
+    UNITY_INTERFACE_EXPORT uint64_t ContextGetDroppedStatsSampleCount(Context* context)
+    {
+        return context->GetStatsSampleBuffer()->GetDroppedCount();
+    }
+
+    struct PipelineLatencySummary
+    {
+        char* track;
+        char* component;
+        uint32_t stage;
+        uint64_t count;
+        double meanUs;
+        uint64_t p50Us;
+        uint64_t p90Us;
+        uint64_t p99Us;
+        uint64_t maxUs;
+    };
+
+    // Returns the summaries of the stages which have recorded any latency.
+    UNITY_INTERFACE_EXPORT PipelineLatencySummary* GetPipelineLatencySummaries(size_t* length)
+    {
+        std::vector<PipelineLatencySummary> summaries;
+        for (const auto& track : MetricsRegistry::GetInstance().GetSnapshot())
+        {
+            for (size_t stage = 0; stage < track.stages.size(); stage++)
+            {
+                const LatencyHistogram::Snapshot& histogram = track.stages[stage];
+                if (histogram.count == 0)
+                    continue;
+                summaries.push_back({ ConvertString(track.trackId),
+                                      ConvertString(track.label),
+                                      static_cast<uint32_t>(stage),
+                                      histogram.count,
+                                      histogram.MeanUs(),
+                                      histogram.PercentileUs(50),
+                                      histogram.PercentileUs(90),
+                                      histogram.PercentileUs(99),
+                                      histogram.maxUs });
+            }
+        }
+        *length = summaries.size();
+        const size_t size = sizeof(PipelineLatencySummary) * summaries.size();
+        auto buf = static_cast<PipelineLatencySummary*>(CoTaskMemAlloc(size));
+        std::copy(summaries.begin(), summaries.end(), buf);
+        return buf;
+    }
+
+    UNITY_INTERFACE_EXPORT char* GetPipelineMetricsText()
+    {
+        return ConvertString(MetricsRegistry::ToText(MetricsRegistry::GetInstance().GetSnapshot()));
+    }
+
+    UNITY_INTERFACE_EXPORT void ResetPipelineMetrics() { MetricsRegistry::GetInstance().Reset(); }
+
+    // Returns false when the samples are passed to the Unity profiler instead of the native trace.
+    UNITY_INTERFACE_EXPORT bool StartNativeTrace()
+    {
+        ChromeTraceProfiler* profiler = Plugin::TraceProfiler();
+        if (!profiler)
+            return false;
+        profiler->SetEnabled(true);
+        return true;
+    }
+
+    UNITY_INTERFACE_EXPORT void StopNativeTrace()
+    {
+        if (ChromeTraceProfiler* profiler = Plugin::TraceProfiler())
+            profiler->SetEnabled(false);
+    }
+
+    // Returns the samples which are recorded since the previous call in the Chrome trace event format.
+    UNITY_INTERFACE_EXPORT char* TakeNativeTraceJson()
+    {
+        ChromeTraceProfiler* profiler = Plugin::TraceProfiler();
+        if (!profiler)
+            return nullptr;
+        return ConvertString(profiler->TakeTraceJson());
+    }
+
     UNITY_INTERFACE_EXPORT void ContextDeleteStatsReport(Context* context, const RTCStatsReport* report)
     {
         context->DeleteStatsReport(report);
@@ -667,7 +804,7 @@ extern "C"
 
     UNITY_INTERFACE_EXPORT const char* StatsGetId(const RTCStats* stats) { return ConvertString(stats->id()); }
 
-    UNITY_INTERFACE_EXPORT uint32_t StatsGetType(const RTCStats* stats) { return statsTypes.at(stats->type()); }
+    UNITY_INTERFACE_EXPORT uint32_t StatsGetType(const RTCStats* stats) { return GetStatsType(stats->type()); }
 
     UNITY_INTERFACE_EXPORT const RTCStatsMemberInterface** StatsGetMembers(const RTCStats* stats, size_t* length)
     {
@@ -1429,6 +1566,42 @@ extern "C"
         channel->Send(webrtc::DataBuffer(buf, true));
     }
 
+    UNITY_INTERFACE_EXPORT int32 DataChannelSendBatch(
+        Context* context, DataChannelInterface* channel, const DataChannelMessage* messages, int32 count)
+    {
+        if (messages == nullptr || count <= 0)
+            return 0;
+        size_t sent = context->GetDataChannelObject(channel)->SendBatch(messages, static_cast<size_t>(count));
+        return static_cast<int32>(sent);
+    }
+
+    UNITY_INTERFACE_EXPORT void DataChannelSendQueued(
+        Context* context, DataChannelInterface* channel, const byte* data, int length, bool binary)
+    {
+        if (length < 0 || (data == nullptr && length > 0))
+            return;
+        context->GetDataChannelObject(channel)->SendQueued(data, static_cast<size_t>(length), binary);
+    }
+
+    UNITY_INTERFACE_EXPORT void DataChannelSetBufferedAmountThresholds(
+        Context* context, DataChannelInterface* channel, uint64_t high, uint64_t low)
+    {
+        if (low > high)
+        {
+            DebugLog(
+                "The low watermark %llu is higher than the high watermark %llu.",
+                static_cast<unsigned long long>(low),
+                static_cast<unsigned long long>(high));
+            return;
+        }
+        context->GetDataChannelObject(channel)->SetBufferedAmountThresholds(high, low);
+    }
+
+    UNITY_INTERFACE_EXPORT uint64_t DataChannelGetQueuedAmount(Context* context, DataChannelInterface* channel)
+    {
+        return context->GetDataChannelObject(channel)->GetQueuedAmount();
+    }
+
     UNITY_INTERFACE_EXPORT void DataChannelClose(DataChannelInterface* channel) { channel->Close(); }
 
     UNITY_INTERFACE_EXPORT void
@@ -1437,6 +1610,36 @@ extern "C"
         context->GetDataChannelObject(channel)->RegisterOnMessage(callback);
     }
 
+    UNITY_INTERFACE_EXPORT void DataChannelEnableMessageArena(
+        Context* context, DataChannelInterface* channel, int32 blockSize, DelegateOnMessagesAvailable callback)
+    {
+        size_t size = blockSize > 0 ? static_cast<size_t>(blockSize) : DataChannelMessageArena::kDefaultBlockSize;
+        context->GetDataChannelObject(channel)->EnableMessageArena(size, callback);
+    }
+
+    UNITY_INTERFACE_EXPORT int32 DataChannelAcquireMessages(
+        Context* context, DataChannelInterface* channel, DataChannelMessage* messages, int32 maxCount)
+    {
+        DataChannelMessageArena* arena = context->GetDataChannelObject(channel)->GetMessageArena();
+        if (arena == nullptr || messages == nullptr || maxCount <= 0)
+            return 0;
+        return static_cast<int32>(arena->Acquire(messages, static_cast<size_t>(maxCount)));
+    }
+
+    UNITY_INTERFACE_EXPORT void DataChannelReleaseMessages(Context* context, DataChannelInterface* channel, int32 count)
+    {
+        DataChannelMessageArena* arena = context->GetDataChannelObject(channel)->GetMessageArena();
+        if (arena == nullptr || count <= 0)
+            return;
+        arena->Release(static_cast<size_t>(count));
+    }
+
+    UNITY_INTERFACE_EXPORT void DataChannelRegisterOnBufferedAmountLow(
+        Context* context, DataChannelInterface* channel, DelegateOnBufferedAmountLow callback)
+    {
+        context->GetDataChannelObject(channel)->RegisterOnBufferedAmountLow(callback);
+    }
+
     UNITY_INTERFACE_EXPORT void
     DataChannelRegisterOnOpen(Context* context, DataChannelInterface* channel, DelegateOnOpen callback)
     {
@@ -1471,6 +1674,13 @@ extern "C"
         }
     }
 
+    UNITY_INTERFACE_EXPORT void AudioSourceProcessLocalAudioBatch(const AudioSourceBatchEntry* entries, int32 count)
+    {
+        if (entries == nullptr || count <= 0)
+            return;
+        UnityAudioTrackSource::PushAudioDataBatch(entries, static_cast<size_t>(count));
+    }
+
     UNITY_INTERFACE_EXPORT AudioTrackSinkAdapter* ContextCreateAudioTrackSink(Context* context)
     {
         return context->CreateAudioTrackSinkAdapter();
@@ -1497,6 +1707,11 @@ extern "C"
         sink->ProcessAudio(data, length, static_cast<size_t>(channels), sampleRate);
     }
 
+    UNITY_INTERFACE_EXPORT void AudioTrackSinkSetTargetLatency(AudioTrackSinkAdapter* sink, int32_t milliseconds)
+    {
+        sink->SetTargetLatency(milliseconds);
+    }
+
     UNITY_INTERFACE_EXPORT uint32_t FrameGetTimestamp(TransformableFrameInterface* frame)
     {
         return frame->GetTimestamp();
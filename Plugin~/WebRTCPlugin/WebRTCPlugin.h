@@ -153,11 +153,14 @@ namespace webrtc
 
     class IGraphicsDevice;
     class ProfilerMarkerFactory;
+    class ChromeTraceProfiler;
     class Plugin
     {
     public:
         static IGraphicsDevice* GraphicsDevice();
         static ProfilerMarkerFactory* ProfilerMarkerFactory();
+        // Null when the Unity profiler is available.
+        static ChromeTraceProfiler* TraceProfiler();
     };
 
 } // end namespace webrtc
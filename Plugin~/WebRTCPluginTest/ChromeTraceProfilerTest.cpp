@@ -0,0 +1,104 @@
+#include "pch.h"
+
+#include <thread>
+
+#include "ChromeTraceProfiler.h"
+#include "ProfilerMarkerFactory.h"
+#include "ScopedProfiler.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    static size_t CountOccurrences(const std::string& str, const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+            count++;
+        return count;
+    }
+
+    class ChromeTraceProfilerTest : public ::testing::Test
+    {
+    protected:
+        ChromeTraceProfilerTest()
+            : factory_(ProfilerMarkerFactory::Create(&profiler_))
+        {
+        }
+
+        ChromeTraceProfiler profiler_;
+        std::unique_ptr<ProfilerMarkerFactory> factory_;
+    };
+
+    TEST_F(ChromeTraceProfilerTest, RecordScopedSamples)
+    {
+        const UnityProfilerMarkerDesc* outer =
+            factory_->CreateMarker("Outer", kUnityProfilerCategoryRender, kUnityProfilerMarkerFlagDefault, 0);
+        const UnityProfilerMarkerDesc* inner = factory_->CreateMarker(
+            "Inner \"quoted\"", kUnityProfilerCategoryRender, kUnityProfilerMarkerFlagDefault, 0);
+        ASSERT_NE(nullptr, outer);
+        EXPECT_STREQ("Outer", outer->name);
+
+        // Nothing is recorded until enabled.
+        factory_->CreateScopedProfiler(*outer);
+        EXPECT_EQ(0u, CountOccurrences(profiler_.TakeTraceJson(), "\"ph\":\"X\""));
+
+        profiler_.SetEnabled(true);
+        {
+            auto outerScope = factory_->CreateScopedProfiler(*outer);
+            auto innerScope = factory_->CreateScopedProfiler(*inner);
+        }
+        std::string json = profiler_.TakeTraceJson();
+        EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+        EXPECT_EQ(2u, CountOccurrences(json, "\"ph\":\"X\""));
+        EXPECT_EQ(1u, CountOccurrences(json, "\"name\":\"Outer\""));
+        EXPECT_EQ(1u, CountOccurrences(json, "\"name\":\"Inner \\\"quoted\\\"\""));
+
+        // The samples are moved out of the buffers.
+        EXPECT_EQ(0u, CountOccurrences(profiler_.TakeTraceJson(), "\"ph\":\"X\""));
+    }
+
+    TEST_F(ChromeTraceProfilerTest, RecordOnThreads)
+    {
+        const UnityProfilerMarkerDesc* marker =
+            factory_->CreateMarker("Encode", kUnityProfilerCategoryRender, kUnityProfilerMarkerFlagDefault, 0);
+        profiler_.SetEnabled(true);
+
+        const int kThreads = 4;
+        const int kSamples = 1000;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kThreads; i++)
+        {
+            threads.emplace_back([this, marker, i]() {
+                auto thread = factory_->CreateScopedProfilerThread("WebRTC", ("Encoder" + std::to_string(i)).c_str());
+                for (int j = 0; j < kSamples; j++)
+                    factory_->CreateScopedProfiler(*marker);
+            });
+        }
+
+        // The trace is taken while the threads are recording.
+        std::string json = profiler_.TakeTraceJson();
+        for (auto& thread : threads)
+            thread.join();
+        json += profiler_.TakeTraceJson();
+
+        EXPECT_EQ(static_cast<size_t>(kThreads * kSamples), CountOccurrences(json, "\"name\":\"Encode\""));
+        EXPECT_EQ(1u, CountOccurrences(json, "\"name\":\"WebRTC.Encoder0\""));
+        EXPECT_EQ(0u, profiler_.GetDroppedCount());
+    }
+
+    TEST(ChromeTraceProfilerDropTest, DropWhenFull)
+    {
+        ChromeTraceProfiler profiler(4);
+        auto factory = ProfilerMarkerFactory::Create(&profiler);
+        const UnityProfilerMarkerDesc* marker =
+            factory->CreateMarker("Decode", kUnityProfilerCategoryRender, kUnityProfilerMarkerFlagDefault, 0);
+        profiler.SetEnabled(true);
+
+        for (int i = 0; i < 10; i++)
+            factory->CreateScopedProfiler(*marker);
+        EXPECT_EQ(6u, profiler.GetDroppedCount());
+        EXPECT_EQ(4u, CountOccurrences(profiler.TakeTraceJson(), "\"ph\":\"X\""));
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -1,5 +1,6 @@
 #include "pch.h"
 
+#include <api/make_ref_counted.h>
 #include <rtc_base/ref_counted_object.h>
 
 #include "Context.h"
@@ -16,6 +17,57 @@ namespace webrtc
 
     using namespace ::webrtc;
 
+    // The data channel whose state and buffered amount are controlled by the test.
+    class FakeDataChannel : public DataChannelInterface
+    {
+    public:
+        void RegisterObserver(DataChannelObserver* observer) override { observer_ = observer; }
+        void UnregisterObserver() override { observer_ = nullptr; }
+        std::string label() const override { return "fake"; }
+        bool reliable() const override { return true; }
+        int id() const override { return 0; }
+        DataState state() const override { return state_; }
+        uint32_t messages_sent() const override { return static_cast<uint32_t>(sent.size()); }
+        uint64_t bytes_sent() const override { return 0; }
+        uint32_t messages_received() const override { return 0; }
+        uint64_t bytes_received() const override { return 0; }
+        uint64_t buffered_amount() const override { return bufferedAmount_; }
+        void Close() override { SetState(kClosed); }
+        bool Send(const DataBuffer& buffer) override
+        {
+            if (state_ != kOpen || refuseCount_ == 0)
+                return false;
+            refuseCount_--;
+            sent.push_back(buffer);
+            bufferedAmount_ += buffer.size();
+            return true;
+        }
+
+        void SetState(DataState state)
+        {
+            state_ = state;
+            if (observer_)
+                observer_->OnStateChange();
+        }
+        // The network sends |size| bytes of the buffered amount.
+        void Drain(uint64_t size)
+        {
+            bufferedAmount_ -= std::min(size, bufferedAmount_);
+            if (observer_)
+                observer_->OnBufferedAmountChange(size);
+        }
+        // Send fails after accepting |count| messages.
+        void RefuseAfter(size_t count) { refuseCount_ = count; }
+
+        std::vector<DataBuffer> sent;
+
+    private:
+        DataChannelObserver* observer_ = nullptr;
+        DataState state_ = kConnecting;
+        uint64_t bufferedAmount_ = 0;
+        size_t refuseCount_ = std::numeric_limits<size_t>::max();
+    };
+
     class ContextTest : public testing::TestWithParam<UnityGfxRenderer>
     {
     protected:
@@ -61,6 +113,27 @@ namespace webrtc
         context = std::make_unique<Context>(dependencies);
     }
 
+    TEST_P(ContextTest, ConstructorWithAudioConfig)
+    {
+        context = nullptr;
+
+        ContextDependencies dependencies;
+        dependencies.device = device_;
+        dependencies.audio.pullOnUnityAudioThread = true;
+        dependencies.audio.sampleRate = 16000;
+        dependencies.audio.channels = 1;
+        EXPECT_TRUE(dependencies.audio.IsValid());
+        context = std::make_unique<Context>(dependencies);
+        EXPECT_EQ(16000, context->GetAudioDevice()->SamplingRate());
+
+        // The sink pulls the audio from the audio device.
+        AudioTrackSinkAdapter* sink = context->CreateAudioTrackSinkAdapter();
+        std::vector<float> data(160);
+        sink->ProcessAudio(data.data(), data.size(), 1, 16000);
+        EXPECT_LT(0, context->GetAudioDevice()->PulledTimeUs());
+        context->DeleteAudioTrackSinkAdapter(sink);
+    }
+
     TEST_P(ContextTest, InitializeAndFinalizeEncoder)
     {
         const auto source = context->CreateVideoSource();
@@ -136,6 +209,116 @@ namespace webrtc
         context->DeletePeerConnection(connection);
     }
 
+    TEST_P(ContextTest, SendBatchOnUnopenedDataChannel)
+    {
+        const webrtc::PeerConnectionInterface::RTCConfiguration config;
+        const auto connection = context->CreatePeerConnection(config);
+        DataChannelInit init;
+        const auto channel = context->CreateDataChannel(connection, "test", init);
+        ASSERT_NE(nullptr, channel);
+
+        const uint8_t data[] = { 1, 2, 3 };
+        const DataChannelMessage messages[] = { { data, 3, true }, { data, 1, false } };
+        EXPECT_EQ(0u, context->GetDataChannelObject(channel)->SendBatch(messages, 2));
+        context->DeleteDataChannel(channel);
+        context->DeletePeerConnection(connection);
+    }
+
+    TEST_P(ContextTest, SendBatch)
+    {
+        const webrtc::PeerConnectionInterface::RTCConfiguration config;
+        const auto connection = context->CreatePeerConnection(config);
+        auto thread = rtc::Thread::Create();
+        thread->Start();
+        auto channel = rtc::make_ref_counted<FakeDataChannel>();
+        auto object = std::make_unique<DataChannelObject>(channel, *connection, thread.get());
+        thread->BlockingCall([&]() { channel->SetState(DataChannelInterface::kOpen); });
+
+        // Each message is the slice of the batch at its offset, including the empty one.
+        const uint8_t data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        const DataChannelMessage messages[] = {
+            { data, 3, true }, { data + 3, 0, false }, { data + 3, 5, false }, { data + 8, 2, true }
+        };
+        EXPECT_EQ(4u, object->SendBatch(messages, 4));
+        ASSERT_EQ(4u, channel->sent.size());
+        for (size_t i = 0; i < 4; i++)
+        {
+            const DataBuffer& sent = channel->sent[i];
+            ASSERT_EQ(static_cast<size_t>(messages[i].size), sent.size()) << "message " << i;
+            EXPECT_EQ(messages[i].binary, sent.binary) << "message " << i;
+            EXPECT_EQ(0, std::memcmp(messages[i].data, sent.data.cdata(), sent.size())) << "message " << i;
+        }
+
+        // The number of the messages before the refused one is returned.
+        channel->sent.clear();
+        channel->RefuseAfter(2);
+        EXPECT_EQ(2u, object->SendBatch(messages, 4));
+        EXPECT_EQ(2u, channel->sent.size());
+
+        object = nullptr;
+        context->DeletePeerConnection(connection);
+    }
+
+    static int s_bufferedAmountLowCount = 0;
+    static void OnBufferedAmountLow(DataChannelInterface*) { s_bufferedAmountLowCount++; }
+
+    TEST_P(ContextTest, SendQueued)
+    {
+        const webrtc::PeerConnectionInterface::RTCConfiguration config;
+        const auto connection = context->CreatePeerConnection(config);
+        auto thread = rtc::Thread::Create();
+        thread->Start();
+        auto channel = rtc::make_ref_counted<FakeDataChannel>();
+        auto object = std::make_unique<DataChannelObject>(channel, *connection, thread.get());
+        s_bufferedAmountLowCount = 0;
+        object->RegisterOnBufferedAmountLow(&OnBufferedAmountLow);
+        object->SetBufferedAmountThresholds(100, 40);
+        auto flush = [&]() { thread->BlockingCall([]() {}); };
+
+        // The messages queued before the channel opens are held.
+        const uint8_t data[30] = {};
+        for (int i = 0; i < 5; i++)
+            object->SendQueued(data, sizeof(data), true);
+        flush();
+        EXPECT_TRUE(channel->sent.empty());
+        EXPECT_EQ(150u, object->GetQueuedAmount());
+
+        // The channel opens and accepts the messages up to the high watermark. The others are held.
+        thread->BlockingCall([&]() { channel->SetState(DataChannelInterface::kOpen); });
+        flush();
+        EXPECT_EQ(3u, channel->sent.size());
+        EXPECT_EQ(90u, channel->buffered_amount());
+        EXPECT_EQ(60u, object->GetQueuedAmount());
+
+        // The network sends the messages. The held messages are passed, and the amount is still above the low
+        // watermark.
+        thread->BlockingCall([&]() { channel->Drain(60); });
+        flush();
+        EXPECT_EQ(5u, channel->sent.size());
+        EXPECT_EQ(0u, object->GetQueuedAmount());
+        EXPECT_EQ(0, s_bufferedAmountLowCount);
+
+        // The callback fires once when the amount falls to the low watermark, not on every later decrease.
+        thread->BlockingCall([&]() { channel->Drain(60); });
+        flush();
+        EXPECT_EQ(1, s_bufferedAmountLowCount);
+        thread->BlockingCall([&]() { channel->Drain(30); });
+        flush();
+        EXPECT_EQ(1, s_bufferedAmountLowCount);
+
+        // The queued messages are dropped when the channel closes.
+        thread->BlockingCall([&]() { channel->RefuseAfter(0); });
+        object->SendQueued(data, sizeof(data), true);
+        flush();
+        EXPECT_EQ(30u, object->GetQueuedAmount());
+        thread->BlockingCall([&]() { channel->SetState(DataChannelInterface::kClosed); });
+        flush();
+        EXPECT_EQ(0u, object->GetQueuedAmount());
+
+        object = nullptr;
+        context->DeletePeerConnection(connection);
+    }
+
     TEST_P(ContextTest, AddTrackAndRemoveTrack)
     {
         const webrtc::PeerConnectionInterface::RTCConfiguration config;
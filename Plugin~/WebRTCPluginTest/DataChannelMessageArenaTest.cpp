@@ -0,0 +1,84 @@
+#include "pch.h"
+
+#include "DataChannelMessageArena.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    class DataChannelMessageArenaTest : public ::testing::Test
+    {
+    protected:
+        void Append(const std::string& message, bool binary = false)
+        {
+            arena_.Append(reinterpret_cast<const uint8_t*>(message.data()), message.size(), binary);
+        }
+
+        static std::string ToString(const DataChannelMessage& message)
+        {
+            return std::string(reinterpret_cast<const char*>(message.data), static_cast<size_t>(message.size));
+        }
+
+        static constexpr size_t kBlockSize = 16;
+        DataChannelMessageArena arena_ { kBlockSize };
+    };
+
+    TEST_F(DataChannelMessageArenaTest, AcquireAndRelease)
+    {
+        EXPECT_TRUE(arena_.Append(reinterpret_cast<const uint8_t*>("hello"), 5, false));
+        // Unity has not acquired the first message yet, so it is not notified again.
+        EXPECT_FALSE(arena_.Append(reinterpret_cast<const uint8_t*>("\x01\x02"), 2, true));
+
+        DataChannelMessage messages[4];
+        ASSERT_EQ(2u, arena_.Acquire(messages, 4));
+        EXPECT_EQ("hello", ToString(messages[0]));
+        EXPECT_FALSE(messages[0].binary);
+        EXPECT_EQ(2, messages[1].size);
+        EXPECT_TRUE(messages[1].binary);
+        EXPECT_EQ(0u, arena_.Acquire(messages, 4));
+
+        // The acquired messages stay valid until they are released.
+        Append("world");
+        EXPECT_EQ("hello", ToString(messages[0]));
+        arena_.Release(2);
+        EXPECT_EQ(1u, arena_.Size());
+
+        ASSERT_EQ(1u, arena_.Acquire(messages, 4));
+        EXPECT_EQ("world", ToString(messages[0]));
+        arena_.Release(1);
+        EXPECT_EQ(0u, arena_.Size());
+    }
+
+    TEST_F(DataChannelMessageArenaTest, ReuseBlocks)
+    {
+        DataChannelMessage messages[8];
+        for (int i = 0; i < 100; i++)
+        {
+            // Three messages do not fit in one block.
+            Append("0123456");
+            Append("789abcd");
+            Append("efghijk");
+            ASSERT_EQ(3u, arena_.Acquire(messages, 8));
+            EXPECT_EQ("789abcd", ToString(messages[1]));
+            arena_.Release(3);
+        }
+        EXPECT_GE(3u, arena_.BlockCount());
+    }
+
+    TEST_F(DataChannelMessageArenaTest, LargeMessage)
+    {
+        const std::string large(kBlockSize * 4, 'x');
+        Append("small");
+        Append(large);
+
+        DataChannelMessage messages[2];
+        ASSERT_EQ(2u, arena_.Acquire(messages, 2));
+        EXPECT_EQ(large, ToString(messages[1]));
+        arena_.Release(2);
+
+        // The block for the large message is freed after the next block is taken.
+        Append("small");
+        EXPECT_GE(2u, arena_.BlockCount());
+    }
+} // end namespace webrtc
+} // end namespace unity
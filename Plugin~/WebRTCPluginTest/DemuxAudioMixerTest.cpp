@@ -0,0 +1,73 @@
+#include "pch.h"
+
+#include "DemuxAudioMixer.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    class FakeAudioMixerSource : public AudioMixer::Source
+    {
+    public:
+        FakeAudioMixerSource(int ssrc, int sampleRate)
+            : ssrc_(ssrc)
+            , sampleRate_(sampleRate)
+        {
+        }
+
+        AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz, AudioFrame* audio_frame) override
+        {
+            requestedSampleRate = sample_rate_hz;
+            pullCount++;
+            audio_frame->UpdateFrame(
+                0,
+                nullptr,
+                static_cast<size_t>(sample_rate_hz / 100),
+                sample_rate_hz,
+                AudioFrame::kNormalSpeech,
+                AudioFrame::kVadUnknown,
+                1);
+            return AudioFrameInfo::kNormal;
+        }
+        int Ssrc() const override { return ssrc_; }
+        int PreferredSampleRate() const override { return sampleRate_; }
+
+        int requestedSampleRate = 0;
+        int pullCount = 0;
+
+    private:
+        const int ssrc_;
+        const int sampleRate_;
+    };
+
+    TEST(DemuxAudioMixerTest, PullEachSource)
+    {
+        auto mixer = DemuxAudioMixer::Create(48000);
+        FakeAudioMixerSource source1(1, 16000);
+        FakeAudioMixerSource source2(2, 48000);
+        EXPECT_TRUE(mixer->AddSource(&source1));
+        EXPECT_TRUE(mixer->AddSource(&source2));
+        EXPECT_FALSE(mixer->AddSource(&source1));
+
+        AudioFrame frame;
+        mixer->Mix(2, &frame);
+        EXPECT_EQ(1, source1.pullCount);
+        EXPECT_EQ(1, source2.pullCount);
+
+        // Each source is pulled at its own rate without resampling.
+        EXPECT_EQ(16000, source1.requestedSampleRate);
+        EXPECT_EQ(48000, source2.requestedSampleRate);
+
+        // The output is silent at the rate of the audio device.
+        EXPECT_TRUE(frame.muted());
+        EXPECT_EQ(48000, frame.sample_rate_hz());
+        EXPECT_EQ(480u, frame.samples_per_channel());
+        EXPECT_EQ(2u, frame.num_channels());
+
+        mixer->RemoveSource(&source1);
+        mixer->Mix(2, &frame);
+        EXPECT_EQ(1, source1.pullCount);
+        EXPECT_EQ(2, source2.pullCount);
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -1,5 +1,7 @@
 #include "pch.h"
 
+#include <thread>
+
 #include "GpuMemoryBufferPool.h"
 #include "GraphicsDevice/ITexture2D.h"
 #include "GraphicsDeviceContainer.h"
@@ -142,6 +144,188 @@ namespace webrtc
         EXPECT_EQ(0u, bufferPool_->bufferCount());
     }
 
+    TEST_P(GpuMemoryBufferPoolTest, ThrottleWhenSourceQuotaExceeded)
+    {
+        const Size kSize(kWidth, kHeight);
+        auto tex = CreateTexture(kSize, kFormat);
+        void* ptr = tex->GetNativeTexturePtrV();
+        int source1 = 0;
+        int source2 = 0;
+
+        std::vector<rtc::scoped_refptr<VideoFrame>> frames;
+        for (uint32_t i = 0; i < bufferedFrameNum; i++)
+        {
+            frames.push_back(bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source1));
+            EXPECT_NE(frames.back(), nullptr);
+        }
+        EXPECT_TRUE(device_->WaitIdleForTest());
+
+        GpuMemoryBufferPool::ThrottleReason reason;
+        auto frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source1, &reason);
+        EXPECT_EQ(frame, nullptr);
+        EXPECT_EQ(GpuMemoryBufferPool::ThrottleReason::kSourceQuotaExceeded, reason);
+
+        auto stats = bufferPool_->GetSourceStats(&source1);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_EQ(1u, stats->throttledCount);
+        EXPECT_EQ(GpuMemoryBufferPool::ThrottleReason::kSourceQuotaExceeded, stats->lastThrottleReason);
+
+        // The other source is not affected.
+        frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source2, &reason);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        EXPECT_NE(frame, nullptr);
+        EXPECT_EQ(GpuMemoryBufferPool::ThrottleReason::kNone, reason);
+    }
+
+    TEST_P(GpuMemoryBufferPoolTest, ThrottleWhenByteBudgetExceeded)
+    {
+        const Size kSize(kWidth, kHeight);
+        auto tex = CreateTexture(kSize, kFormat);
+        void* ptr = tex->GetNativeTexturePtrV();
+        int source1 = 0;
+        int source2 = 0;
+
+        // The budget is only for one buffer with the texture for CPU readback.
+        GpuMemoryBufferPool pool(device_, &clock_, GpuMemoryBufferPool::EstimateTextureBytes(kSize, kFormat) * 2);
+        auto frame1 = pool.CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source1);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        EXPECT_NE(frame1, nullptr);
+
+        GpuMemoryBufferPool::ThrottleReason reason;
+        auto frame2 = pool.CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source2, &reason);
+        EXPECT_EQ(frame2, nullptr);
+        EXPECT_EQ(GpuMemoryBufferPool::ThrottleReason::kByteBudgetExceeded, reason);
+        EXPECT_EQ(1u, pool.bufferCount());
+        EXPECT_LE(pool.allocatedBytes(), pool.maxBytes());
+
+        // The buffer is reused after returned.
+        frame1 = nullptr;
+        frame2 = pool.CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source2, &reason);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        EXPECT_NE(frame2, nullptr);
+        EXPECT_EQ(GpuMemoryBufferPool::ThrottleReason::kNone, reason);
+        EXPECT_EQ(1u, pool.bufferCount());
+    }
+
+    TEST_P(GpuMemoryBufferPoolTest, CopyForCpuReadOnDemand)
+    {
+        const Size kSize(kWidth, kHeight);
+        auto tex = CreateTexture(kSize, kFormat);
+        void* ptr = tex->GetNativeTexturePtrV();
+        int source = 0;
+
+        // The texture for CPU readback is copied until knowing the consumer doesn't need it.
+        auto frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        EXPECT_NE(frame->GetGpuMemoryBuffer()->ToI420(), nullptr);
+        frame = nullptr;
+        const size_t allocatedBytes = bufferPool_->allocatedBytes();
+
+        // No consumer reads the frame, so the texture for CPU readback is detached.
+        clock_.AdvanceTime(TimeDelta::Seconds(5));
+        frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        auto stats = bufferPool_->GetSourceStats(&source);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_FALSE(stats->cpuRead);
+        EXPECT_EQ(GpuMemoryBufferPool::EstimateTextureBytes(kSize, kFormat), stats->inUseBytes);
+        EXPECT_EQ(allocatedBytes, bufferPool_->allocatedBytes());
+
+        // The request of CPU readback enables copying from the next frame.
+        EXPECT_EQ(frame->GetGpuMemoryBuffer()->ToI420(), nullptr);
+        frame = nullptr;
+        frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        EXPECT_NE(frame->GetGpuMemoryBuffer()->ToI420(), nullptr);
+        EXPECT_EQ(allocatedBytes, bufferPool_->allocatedBytes());
+        EXPECT_EQ(1u, bufferPool_->bufferCount());
+    }
+
+    TEST_P(GpuMemoryBufferPoolTest, ReadbackAfterIdle)
+    {
+        const Size kSize(kWidth, kHeight);
+        auto tex = CreateTexture(kSize, kFormat);
+        void* ptr = tex->GetNativeTexturePtrV();
+        int source = 0;
+
+        // A hardware encoder consumes the frames, so the texture for CPU readback is detached.
+        auto frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        frame = nullptr;
+        clock_.AdvanceTime(TimeDelta::Seconds(5));
+        frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        auto stats = bufferPool_->GetSourceStats(&source);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_FALSE(stats->cpuRead);
+
+        // A software encoder starts consuming. The first frame is dropped instead of converting the texture which has
+        // not been copied, and the texture is attached again on the next capture.
+        EXPECT_EQ(frame->GetGpuMemoryBuffer()->ToI420(), nullptr);
+        frame = nullptr;
+        stats = bufferPool_->GetSourceStats(&source);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_TRUE(stats->cpuRead);
+
+        frame = bufferPool_->CreateFrame(ptr, kSize, kFormat, clock_.CurrentTime(), &source);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        auto i420 = frame->GetGpuMemoryBuffer()->ToI420();
+        ASSERT_NE(i420, nullptr);
+        EXPECT_EQ(kSize.width(), i420->width());
+        EXPECT_EQ(kSize.height(), i420->height());
+    }
+
+    TEST_P(GpuMemoryBufferPoolTest, AcquireAndReturnCostIsFlat)
+    {
+        const Size kSizes[] = { Size(64, 64), Size(128, 64), Size(64, 128), Size(128, 128) };
+        const size_t kBucketCount = std::size(kSizes);
+        std::vector<std::unique_ptr<ITexture2D>> textures;
+        for (const Size& size : kSizes)
+            textures.push_back(CreateTexture(size, kFormat));
+
+        // Each live buffer has its own source, so that the quota of the source does not throttle it.
+        const size_t kMaxLiveBuffers = 64;
+        std::vector<int> sources(kMaxLiveBuffers);
+        auto acquire = [&](size_t count) {
+            std::vector<rtc::scoped_refptr<VideoFrame>> frames;
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t bucket = i % kBucketCount;
+                frames.push_back(bufferPool_->CreateFrame(
+                    textures[bucket]->GetNativeTexturePtrV(),
+                    kSizes[bucket],
+                    kFormat,
+                    clock_.CurrentTime(),
+                    &sources[i]));
+                EXPECT_NE(frames.back(), nullptr);
+            }
+            EXPECT_TRUE(device_->WaitIdleForTest());
+            return frames;
+        };
+        // The buffers are returned on the encoder threads.
+        auto returnOnOtherThread = [](std::vector<rtc::scoped_refptr<VideoFrame>> frames) {
+            std::thread thread([&frames]() { frames.clear(); });
+            thread.join();
+        };
+
+        for (size_t liveBuffers = 1; liveBuffers <= kMaxLiveBuffers; liveBuffers *= 2)
+        {
+            returnOnOtherThread(acquire(liveBuffers));
+            const size_t bufferCount = bufferPool_->bufferCount();
+            EXPECT_GE(bufferCount, liveBuffers);
+
+            // Every acquire takes the head of the free-list of its bucket without visiting other buffers, however
+            // many buffers are in the pool.
+            const uint64_t popCount = bufferPool_->freeListPopCount();
+            auto frames = acquire(liveBuffers);
+            EXPECT_EQ(popCount + liveBuffers, bufferPool_->freeListPopCount()) << "live buffers:" << liveBuffers;
+            EXPECT_EQ(bufferCount, bufferPool_->bufferCount());
+            for (size_t i = 0; i < liveBuffers; i++)
+                EXPECT_EQ(kSizes[i % kBucketCount], frames[i]->size());
+            returnOnOtherThread(std::move(frames));
+        }
+    }
+
     INSTANTIATE_TEST_SUITE_P(GfxDevice, GpuMemoryBufferPoolTest, testing::ValuesIn(supportedGfxDevices));
 
 } // end namespace webrtc
@@ -114,6 +114,65 @@ namespace webrtc
         EXPECT_EQ(height, frameBuffer->height());
     }
 
+    TEST_P(GraphicsDeviceTest, ConvertRGBToNV12)
+    {
+        const uint32_t width = 256;
+        const uint32_t height = 256;
+        const std::unique_ptr<ITexture2D> src(device()->CreateDefaultTextureV(width, height, format()));
+        const std::unique_ptr<ITexture2D> dst(device()->CreateCPUReadTextureV(width, height, format()));
+        EXPECT_TRUE(device()->WaitIdleForTest());
+        EXPECT_TRUE(device()->CopyResourceFromNativeV(dst.get(), src->GetNativeTexturePtrV()));
+        EXPECT_TRUE(device()->WaitIdleForTest());
+        const auto frameBuffer = device()->ConvertRGBToNV12(dst.get());
+        EXPECT_NE(nullptr, frameBuffer);
+        EXPECT_EQ(width, frameBuffer->width());
+        EXPECT_EQ(height, frameBuffer->height());
+    }
+
+    TEST_P(GraphicsDeviceTest, ConvertRGBToI420ReusesBuffer)
+    {
+        const uint32_t width = 256;
+        const uint32_t height = 256;
+        const std::unique_ptr<ITexture2D> src(device()->CreateDefaultTextureV(width, height, format()));
+        const std::unique_ptr<ITexture2D> dst(device()->CreateCPUReadTextureV(width, height, format()));
+        EXPECT_TRUE(device()->WaitIdleForTest());
+        EXPECT_TRUE(device()->CopyResourceFromNativeV(dst.get(), src->GetNativeTexturePtrV()));
+        EXPECT_TRUE(device()->WaitIdleForTest());
+
+        const FrameBufferPool::Stats before = device()->GetFrameBufferPoolStats();
+        rtc::scoped_refptr<::webrtc::I420Buffer> frameBuffer = device()->ConvertRGBToI420(dst.get());
+        ASSERT_NE(nullptr, frameBuffer);
+        const ::webrtc::I420Buffer* first = frameBuffer.get();
+        frameBuffer = nullptr;
+
+        // The buffer which is no longer referenced is reused.
+        frameBuffer = device()->ConvertRGBToI420(dst.get());
+        ASSERT_NE(nullptr, frameBuffer);
+        EXPECT_EQ(first, frameBuffer.get());
+
+        const FrameBufferPool::Stats after = device()->GetFrameBufferPoolStats();
+        EXPECT_EQ(before.hitCount + before.missCount + 2, after.hitCount + after.missCount);
+        EXPECT_LE(before.hitCount + 1, after.hitCount);
+    }
+
+    TEST_P(GraphicsDeviceTest, WaitSyncAfterCopyToCPURead)
+    {
+        const uint32_t width = 256;
+        const uint32_t height = 256;
+        const std::unique_ptr<ITexture2D> src(device()->CreateDefaultTextureV(width, height, format()));
+        const std::unique_ptr<ITexture2D> dst(device()->CreateCPUReadTextureV(width, height, format()));
+        EXPECT_TRUE(device()->WaitIdleForTest());
+        EXPECT_TRUE(device()->CopyResourceFromNativeV(dst.get(), src->GetNativeTexturePtrV()));
+
+        using namespace std::chrono_literals;
+        const std::chrono::nanoseconds timeout(1s);
+        EXPECT_TRUE(device()->WaitSync(dst.get(), timeout.count()));
+        const auto frameBuffer = device()->ConvertRGBToI420(dst.get());
+        EXPECT_NE(nullptr, frameBuffer);
+        EXPECT_TRUE(device()->WaitIdleForTest());
+        EXPECT_TRUE(device()->ResetSync(dst.get()));
+    }
+
     TEST_P(GraphicsDeviceTest, Map)
     {
         const uint32_t width = 256;
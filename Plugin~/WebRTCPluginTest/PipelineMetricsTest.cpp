@@ -0,0 +1,124 @@
+#include "pch.h"
+
+#include <thread>
+
+#include "PipelineMetrics.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    TEST(LatencyHistogramTest, BucketIndex)
+    {
+        // Each value falls in the bucket whose upper bound is not less than it, and the error is within 1/16.
+        size_t previous = 0;
+        for (uint64_t value = 0; value < 1000000; value += 1 + value / 100)
+        {
+            const size_t index = LatencyHistogram::BucketIndex(value);
+            ASSERT_LT(index, LatencyHistogram::kBucketCount);
+            ASSERT_GE(index, previous);
+            ASSERT_GE(LatencyHistogram::BucketUpperBound(index), value);
+            ASSERT_LE(LatencyHistogram::BucketUpperBound(index) - value, value / 16);
+            previous = index;
+        }
+        EXPECT_EQ(LatencyHistogram::kBucketCount - 1, LatencyHistogram::BucketIndex(UINT64_MAX));
+    }
+
+    TEST(LatencyHistogramTest, Percentile)
+    {
+        LatencyHistogram histogram;
+        for (int64_t i = 1; i <= 1000; i++)
+            histogram.Record(i);
+
+        const LatencyHistogram::Snapshot snapshot = histogram.GetSnapshot();
+        EXPECT_EQ(1000u, snapshot.count);
+        EXPECT_EQ(1000u, snapshot.maxUs);
+        EXPECT_DOUBLE_EQ(500.5, snapshot.MeanUs());
+        EXPECT_NEAR(500, snapshot.PercentileUs(50), 500 / 16);
+        EXPECT_NEAR(990, snapshot.PercentileUs(99), 990 / 16);
+        EXPECT_EQ(1000u, snapshot.PercentileUs(100));
+
+        histogram.Reset();
+        EXPECT_EQ(0u, histogram.GetSnapshot().count);
+    }
+
+    TEST(LatencyHistogramTest, RecordConcurrently)
+    {
+        LatencyHistogram histogram;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++)
+        {
+            threads.emplace_back([&histogram, i]() {
+                for (int j = 0; j < 10000; j++)
+                    histogram.Record(i * 1000 + j % 100);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        const LatencyHistogram::Snapshot snapshot = histogram.GetSnapshot();
+        EXPECT_EQ(40000u, snapshot.count);
+        EXPECT_EQ(3099u, snapshot.maxUs);
+    }
+
+    TEST(MetricsRegistryTest, Snapshot)
+    {
+        MetricsRegistry& registry = MetricsRegistry::GetInstance();
+        std::shared_ptr<TrackMetrics> metrics = registry.Register("encoder");
+        metrics->Record(PipelineStage::kEncode, 1000);
+        metrics->Record(PipelineStage::kEncode, 3000);
+
+        bool found = false;
+        for (const auto& track : registry.GetSnapshot())
+        {
+            if (track.label != metrics->label())
+                continue;
+            found = true;
+            EXPECT_EQ(2u, track.stages[static_cast<size_t>(PipelineStage::kEncode)].count);
+            EXPECT_EQ(0u, track.stages[static_cast<size_t>(PipelineStage::kDecode)].count);
+
+            const std::string text = MetricsRegistry::ToText({ track });
+            EXPECT_NE(std::string::npos, text.find("stage=\"encode\""));
+            EXPECT_NE(
+                std::string::npos,
+                text.find("webrtc_pipeline_latency_us_count{track=\"\",component=\"" + track.label + "\""));
+            EXPECT_EQ(std::string::npos, text.find("stage=\"decode\""));
+        }
+        EXPECT_TRUE(found);
+
+        // The metrics of the destroyed component disappear.
+        const std::string label = metrics->label();
+        metrics = nullptr;
+        for (const auto& track : registry.GetSnapshot())
+            EXPECT_NE(label, track.label);
+    }
+
+    TEST(MetricsRegistryTest, TrackId)
+    {
+        // The source knows the track when it is registered, and the encoder learns it later.
+        MetricsRegistry& registry = MetricsRegistry::GetInstance();
+        std::shared_ptr<TrackMetrics> source = registry.Register("source", "video0");
+        std::shared_ptr<TrackMetrics> encoder = registry.Register("encoder");
+        EXPECT_EQ("", encoder->trackId());
+        encoder->SetTrackId(source->trackId());
+        source->Record(PipelineStage::kQueueWait, 1000);
+        encoder->Record(PipelineStage::kEncode, 2000);
+
+        std::vector<MetricsRegistry::TrackSnapshot> stages;
+        for (const auto& track : registry.GetSnapshot())
+        {
+            if (track.trackId == "video0")
+                stages.push_back(track);
+        }
+        ASSERT_EQ(2u, stages.size());
+        EXPECT_NE(stages[0].label, stages[1].label);
+
+        const std::string text = MetricsRegistry::ToText(stages);
+        EXPECT_NE(
+            std::string::npos,
+            text.find("track=\"video0\",component=\"" + source->label() + "\",stage=\"queue_wait\""));
+        EXPECT_NE(
+            std::string::npos, text.find("track=\"video0\",component=\"" + encoder->label() + "\",stage=\"encode\""));
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,121 @@
+#include "pch.h"
+
+#include <api/stats/rtcstats_objects.h>
+
+#include "StatsSampler.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    class StatsSamplerTest : public ::testing::Test
+    {
+    protected:
+        StatsSamplerTest()
+            : thread_(rtc::Thread::Create())
+        {
+            thread_->Start();
+            sampler_ = std::make_unique<StatsSampler>(nullptr, nullptr, thread_.get(), &buffer_);
+        }
+
+        void Process(uint64_t bytesSent, uint32_t packetsSent, int64_t timestampUs, const std::string& id = "outbound")
+        {
+            auto report = RTCStatsReport::Create(timestampUs);
+            auto stats = std::make_unique<RTCOutboundRTPStreamStats>(id, timestampUs);
+            stats->bytes_sent = bytesSent;
+            stats->packets_sent = packetsSent;
+            stats->kind = "video";
+            report->AddStats(std::move(stats));
+            thread_->BlockingCall([&]() { sampler_->ProcessReport(*report); });
+        }
+
+        std::vector<StatsSample> ReadAll()
+        {
+            std::vector<StatsSample> samples(64);
+            samples.resize(buffer_.Read(samples.data(), samples.size()));
+            return samples;
+        }
+
+        size_t GetStringCount()
+        {
+            return thread_->BlockingCall([&]() { return buffer_.GetStringCount(); });
+        }
+
+        std::unique_ptr<rtc::Thread> thread_;
+        StatsSampleBuffer buffer_;
+        std::unique_ptr<StatsSampler> sampler_;
+    };
+
+    TEST_F(StatsSamplerTest, PushChangedMembers)
+    {
+        // All the numeric members are pushed on the first report. The string members are skipped.
+        Process(1000, 10, 1000);
+        std::vector<StatsSample> samples = ReadAll();
+        ASSERT_EQ(2u, samples.size());
+        for (const StatsSample& sample : samples)
+        {
+            EXPECT_STREQ("outbound", sample.statsId);
+            EXPECT_EQ(0, sample.delta);
+        }
+
+        // Only the bytes changed.
+        Process(1500, 10, 2000);
+        samples = ReadAll();
+        ASSERT_EQ(1u, samples.size());
+        EXPECT_STREQ("bytesSent", samples[0].member);
+        EXPECT_EQ(1500, samples[0].value);
+        EXPECT_EQ(500, samples[0].delta);
+        EXPECT_EQ(2000, samples[0].timestampUs);
+
+        Process(1500, 10, 3000);
+        EXPECT_TRUE(ReadAll().empty());
+    }
+
+    TEST_F(StatsSamplerTest, DropWhenFull)
+    {
+        StatsSampleBuffer buffer(2);
+        const char* id = buffer.AcquireString("id");
+        EXPECT_EQ(id, buffer.AcquireString("id"));
+        buffer.Push(nullptr, id, "a", 0, 1, 0);
+        buffer.Push(nullptr, id, "b", 0, 1, 0);
+        buffer.Push(nullptr, id, "c", 0, 1, 0);
+        EXPECT_EQ(1u, buffer.GetDroppedCount());
+
+        StatsSample samples[4];
+        ASSERT_EQ(2u, buffer.Read(samples, 4));
+        EXPECT_EQ(samples[0].statsId, samples[1].statsId);
+        buffer.ReleaseString(id);
+        buffer.ReleaseString(id);
+    }
+
+    TEST_F(StatsSamplerTest, FreeIdsOfRemovedStats)
+    {
+        // Every report has a new id, like the stats of the renegotiated streams.
+        const int kReports = 100;
+        for (int i = 0; i < kReports; i++)
+        {
+            Process(1000, 10, 1000 * i, "outbound" + std::to_string(i));
+            std::vector<StatsSample> samples = ReadAll();
+            ASSERT_EQ(2u, samples.size());
+            EXPECT_EQ("outbound" + std::to_string(i), samples[0].statsId);
+        }
+        // Only the id in the report and the ids released in the last reports are kept.
+        EXPECT_GE(3u, GetStringCount());
+
+        // The id is kept while the samples which refer to it are not read.
+        Process(1000, 10, 1000 * kReports, "outbound");
+        Process(1000, 10, 1000 * (kReports + 1), "inbound");
+        std::vector<StatsSample> samples = ReadAll();
+        ASSERT_EQ(4u, samples.size());
+        EXPECT_STREQ("outbound", samples[0].statsId);
+        EXPECT_STREQ("inbound", samples[2].statsId);
+
+        // All the ids are freed once the sampler is stopped and the samples are read.
+        sampler_.reset();
+        ReadAll();
+        const char* str = thread_->BlockingCall([&]() { return buffer_.AcquireString(""); });
+        EXPECT_EQ(1u, GetStringCount());
+        thread_->BlockingCall([&]() { buffer_.ReleaseString(str); });
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -0,0 +1,162 @@
+#include "pch.h"
+
+#include <api/stats/rtcstats_objects.h>
+
+#include "StatsSnapshot.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // Reads the values from the snapshot in order.
+    class SnapshotReader
+    {
+    public:
+        explicit SnapshotReader(const std::vector<uint8_t>& data)
+            : data_(data)
+        {
+        }
+
+        template<typename T>
+        T Get()
+        {
+            T value;
+            EXPECT_LE(offset_ + sizeof(T), data_.size());
+            std::memcpy(&value, data_.data() + offset_, sizeof(T));
+            offset_ += sizeof(T);
+            return value;
+        }
+
+        std::string GetString()
+        {
+            const uint32_t length = Get<uint32_t>();
+            std::string str(reinterpret_cast<const char*>(data_.data() + offset_), length);
+            offset_ += length;
+            return str;
+        }
+
+        bool AtEnd() const { return offset_ == data_.size(); }
+
+    private:
+        const std::vector<uint8_t>& data_;
+        size_t offset_ = 0;
+    };
+
+    TEST(StatsSnapshotTest, Write)
+    {
+        auto report = RTCStatsReport::Create(1000);
+        auto codec = std::make_unique<RTCCodecStats>("codec1", 2000);
+        codec->payload_type = 111;
+        codec->mime_type = "audio/opus";
+        report->AddStats(std::move(codec));
+        auto dataChannel = std::make_unique<RTCDataChannelStats>("dc1", 3000);
+        dataChannel->label = "audio/opus";
+        dataChannel->bytes_sent = 12345;
+        report->AddStats(std::move(dataChannel));
+
+        StatsSnapshotWriter writer;
+        const std::vector<uint8_t> snapshot = writer.Write(*report);
+
+        SnapshotReader reader(snapshot);
+        EXPECT_EQ(StatsSnapshotWriter::kMagic, reader.Get<uint32_t>());
+        EXPECT_EQ(StatsSnapshotWriter::kVersion, reader.Get<uint16_t>());
+        reader.Get<uint16_t>();
+        EXPECT_EQ(1000, reader.Get<int64_t>());
+
+        // The same string is interned once.
+        const uint32_t stringCount = reader.Get<uint32_t>();
+        const uint32_t statsCount = reader.Get<uint32_t>();
+        EXPECT_EQ(2u, statsCount);
+        std::vector<std::string> strings;
+        for (uint32_t i = 0; i < stringCount; i++)
+            strings.push_back(reader.GetString());
+        EXPECT_EQ(1, std::count(strings.begin(), strings.end(), "audio/opus"));
+
+        // The stats are ordered by the id in the report.
+        // All the members are written, and the undefined members have no value.
+        EXPECT_EQ("codec1", strings[reader.Get<uint32_t>()]);
+        EXPECT_EQ(0u, reader.Get<uint32_t>());
+        EXPECT_EQ(2000, reader.Get<int64_t>());
+        uint32_t memberCount = reader.Get<uint32_t>();
+        EXPECT_EQ(RTCCodecStats("codec1", 2000).Members().size(), memberCount);
+        int definedCount = 0;
+        for (uint32_t i = 0; i < memberCount; i++)
+        {
+            const std::string name = strings[reader.Get<uint32_t>()];
+            const uint8_t type = reader.Get<uint8_t>();
+            if (type & StatsSnapshotWriter::kUndefinedMember)
+                continue;
+            definedCount++;
+            if (name == "payloadType")
+            {
+                EXPECT_EQ(RTCStatsMemberInterface::kUint32, type);
+                EXPECT_EQ(111u, reader.Get<uint32_t>());
+            }
+            else
+            {
+                EXPECT_EQ("mimeType", name);
+                EXPECT_EQ(RTCStatsMemberInterface::kString, type);
+                EXPECT_EQ("audio/opus", strings[reader.Get<uint32_t>()]);
+            }
+        }
+        EXPECT_EQ(2, definedCount);
+
+        EXPECT_EQ("dc1", strings[reader.Get<uint32_t>()]);
+        EXPECT_EQ(8u, reader.Get<uint32_t>());
+        EXPECT_EQ(3000, reader.Get<int64_t>());
+        memberCount = reader.Get<uint32_t>();
+        EXPECT_EQ(RTCDataChannelStats("dc1", 3000).Members().size(), memberCount);
+        definedCount = 0;
+        for (uint32_t i = 0; i < memberCount; i++)
+        {
+            const std::string name = strings[reader.Get<uint32_t>()];
+            const uint8_t type = reader.Get<uint8_t>();
+            if (type & StatsSnapshotWriter::kUndefinedMember)
+                continue;
+            definedCount++;
+            if (name == "bytesSent")
+            {
+                EXPECT_EQ(RTCStatsMemberInterface::kUint64, type);
+                EXPECT_EQ(12345u, reader.Get<uint64_t>());
+            }
+            else
+            {
+                EXPECT_EQ("label", name);
+                EXPECT_EQ("audio/opus", strings[reader.Get<uint32_t>()]);
+            }
+        }
+        EXPECT_EQ(2, definedCount);
+        EXPECT_TRUE(reader.AtEnd());
+    }
+
+    TEST(StatsSnapshotTest, FilterByType)
+    {
+        auto report = RTCStatsReport::Create(1000);
+        report->AddStats(std::make_unique<RTCCodecStats>("codec1", 1000));
+        report->AddStats(std::make_unique<RTCDataChannelStats>("dc1", 1000));
+
+        StatsSnapshotWriter writer;
+        const std::vector<uint8_t> snapshot = writer.Write(*report, 1u << GetStatsType("data-channel"));
+
+        SnapshotReader reader(snapshot);
+        reader.Get<uint32_t>();
+        reader.Get<uint16_t>();
+        reader.Get<uint16_t>();
+        reader.Get<int64_t>();
+        const uint32_t stringCount = reader.Get<uint32_t>();
+        EXPECT_EQ(1u, reader.Get<uint32_t>());
+        std::vector<std::string> strings;
+        for (uint32_t i = 0; i < stringCount; i++)
+            strings.push_back(reader.GetString());
+        EXPECT_EQ("dc1", strings[reader.Get<uint32_t>()]);
+    }
+
+    TEST(StatsTypesTest, GetStatsType)
+    {
+        for (size_t i = 0; i < kStatsTypeNames.size(); i++)
+            EXPECT_EQ(i, GetStatsType(kStatsTypeNames[i]));
+        EXPECT_EQ(kUnknownStatsType, GetStatsType(""));
+        EXPECT_EQ(kUnknownStatsType, GetStatsType("outbound"));
+    }
+} // end namespace webrtc
+} // end namespace unity
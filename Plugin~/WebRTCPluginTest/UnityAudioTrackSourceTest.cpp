@@ -0,0 +1,119 @@
+#include "pch.h"
+
+#include <thread>
+
+#include "UnityAudioTrackSource.h"
+
+namespace unity
+{
+namespace webrtc
+{
+    // Records the first channel of the audio passed to the sink.
+    class FakeAudioSink : public AudioTrackSinkInterface
+    {
+    public:
+        void OnData(
+            const void* audio_data,
+            int bits_per_sample,
+            int sample_rate,
+            size_t number_of_channels,
+            size_t number_of_frames) override
+        {
+            EXPECT_EQ(16, bits_per_sample);
+            EXPECT_EQ(static_cast<size_t>(sample_rate / 100), number_of_frames);
+            const int16_t* data = static_cast<const int16_t*>(audio_data);
+            for (size_t i = 0; i < number_of_frames; i++)
+                samples.push_back(data[i * number_of_channels]);
+            chunkCount++;
+        }
+
+        std::vector<int16_t> samples;
+        int chunkCount = 0;
+    };
+
+    TEST(UnityAudioTrackSourceTest, PushAudioDataBatch)
+    {
+        const int kSampleRate = 48000;
+        const int kChannels = 2;
+        // Unity passes 1024 frames on each callback, which is not a multiple of 10ms.
+        const int kFrames = 1024;
+        const int kCallbacks = 10;
+        const size_t kSources = 3;
+
+        std::vector<rtc::scoped_refptr<UnityAudioTrackSource>> sources;
+        std::vector<FakeAudioSink> sinks(kSources);
+        for (size_t i = 0; i < kSources; i++)
+        {
+            sources.push_back(UnityAudioTrackSource::Create());
+            sources[i]->AddSink(&sinks[i]);
+        }
+
+        // Each source has a distinct ramp, so the order and the origin of the samples can be checked.
+        auto sampleAt = [](size_t source, int frame) { return static_cast<int16_t>((frame + source * 100) % 1000); };
+        std::vector<std::vector<float>> data(kSources, std::vector<float>(kFrames * kChannels));
+        for (int callback = 0; callback < kCallbacks; callback++)
+        {
+            std::vector<AudioSourceBatchEntry> entries;
+            for (size_t i = 0; i < kSources; i++)
+            {
+                for (int frame = 0; frame < kFrames; frame++)
+                {
+                    const float value = sampleAt(i, callback * kFrames + frame) / 32768.0f;
+                    std::fill_n(&data[i][frame * kChannels], kChannels, value);
+                }
+                // Like AudioSourceProcessLocalAudio, the length of the interleaved array is passed as the frames.
+                entries.push_back({ sources[i].get(), data[i].data(), kSampleRate, kChannels, kFrames * kChannels });
+            }
+            // The entry without the source is skipped.
+            entries.push_back({ nullptr, nullptr, kSampleRate, kChannels, kFrames * kChannels });
+            UnityAudioTrackSource::PushAudioDataBatch(entries.data(), entries.size());
+        }
+
+        // Every complete 10ms chunk is delivered, and the remainder waits for the next callback.
+        const int expectedChunks = kFrames * kCallbacks / (kSampleRate / 100);
+        for (size_t i = 0; i < kSources; i++)
+        {
+            EXPECT_EQ(expectedChunks, sinks[i].chunkCount);
+            ASSERT_EQ(static_cast<size_t>(expectedChunks * kSampleRate / 100), sinks[i].samples.size());
+            for (size_t frame = 0; frame < sinks[i].samples.size(); frame++)
+                ASSERT_EQ(sampleAt(i, static_cast<int>(frame)), sinks[i].samples[frame]) << "source " << i;
+            sources[i]->RemoveSink(&sinks[i]);
+        }
+    }
+
+    // Fails when it is called after RemoveSink has returned.
+    class RemovedAudioSink : public AudioTrackSinkInterface
+    {
+    public:
+        void OnData(const void*, int, int, size_t, size_t) override { EXPECT_FALSE(removed.load()); }
+
+        std::atomic<bool> removed { false };
+    };
+
+    TEST(UnityAudioTrackSourceTest, RemoveSinkDuringPush)
+    {
+        const int kSampleRate = 48000;
+        const int kChannels = 2;
+        const int kFrames = 480;
+        const std::vector<float> data(kFrames * kChannels);
+
+        for (int i = 0; i < 100; i++)
+        {
+            rtc::scoped_refptr<UnityAudioTrackSource> source = UnityAudioTrackSource::Create();
+            RemovedAudioSink sink;
+            source->AddSink(&sink);
+
+            std::atomic<bool> stop { false };
+            std::thread audioThread([&]() {
+                while (!stop.load())
+                    source->PushAudioData(data.data(), kSampleRate, kChannels, kFrames * kChannels);
+            });
+            std::this_thread::yield();
+            source->RemoveSink(&sink);
+            sink.removed = true;
+            stop = true;
+            audioThread.join();
+        }
+    }
+} // end namespace webrtc
+} // end namespace unity
@@ -139,5 +139,82 @@ namespace webrtc
 
         scheduler_ = nullptr;
     }
+
+    TEST_F(VideoFrameSchedulerTest, OnFrameCaptured)
+    {
+        FakeTaskQueue queue(&clock_);
+        InitScheduler(queue);
+        EXPECT_EQ(0, count_);
+
+        // The captured frame is delivered without waiting for the timer.
+        auto frame = VideoFrame::WrapExternalGpuMemoryBuffer(Size(256, 256), nullptr, nullptr, TimeDelta::Zero());
+        const TimeDelta elapsed = TimeDelta::Millis(20);
+        clock_.AdvanceTime(elapsed);
+        scheduler_->OnFrameCaptured(frame.get());
+        EXPECT_EQ(1, count_);
+
+        // The timer doesn't capture the frame which has been delivered.
+        EXPECT_FALSE(queue.AdvanceTimeAndRunLastTask());
+        EXPECT_EQ(1, count_);
+
+        // The timer repeats the frame when no new frame is captured in the interval.
+        EXPECT_FALSE(queue.AdvanceTimeAndRunLastTask());
+        EXPECT_EQ(2, count_);
+
+        scheduler_ = nullptr;
+    }
+
+    TEST_F(VideoFrameSchedulerTest, TimerDeliversThrottledFrame)
+    {
+        FakeTaskQueue queue(&clock_);
+        InitScheduler(queue);
+        EXPECT_EQ(0, count_);
+
+        auto frame = VideoFrame::WrapExternalGpuMemoryBuffer(Size(256, 256), nullptr, nullptr, TimeDelta::Zero());
+        clock_.AdvanceTime(TimeDelta::Millis(20));
+        scheduler_->OnFrameCaptured(frame.get());
+        EXPECT_EQ(1, count_);
+
+        // The frame exceeding the rate is throttled.
+        clock_.AdvanceTime(TimeDelta::Millis(5));
+        scheduler_->OnFrameCaptured(frame.get());
+        EXPECT_EQ(1, count_);
+
+        // The next tick of the timer delivers the throttled frame, and the next capture is one interval later.
+        EXPECT_FALSE(queue.AdvanceTimeAndRunLastTask());
+        EXPECT_EQ(2, count_);
+        EXPECT_EQ(kTimeDelta, queue.last_delay());
+
+        // Nothing is pending, so the timer repeats the frame at the next interval.
+        EXPECT_FALSE(queue.AdvanceTimeAndRunLastTask());
+        EXPECT_EQ(3, count_);
+
+        scheduler_ = nullptr;
+    }
+
+    TEST_F(VideoFrameSchedulerTest, OnFrameCapturedLimitsFramerate)
+    {
+        FakeTaskQueue queue(&clock_);
+        InitScheduler(queue);
+        EXPECT_EQ(0, count_);
+
+        // Captures frames at 100fps for one second.
+        auto frame = VideoFrame::WrapExternalGpuMemoryBuffer(Size(256, 256), nullptr, nullptr, TimeDelta::Zero());
+        for (int i = 0; i < 100; i++)
+        {
+            clock_.AdvanceTime(TimeDelta::Millis(10));
+            scheduler_->OnFrameCaptured(frame.get());
+        }
+        EXPECT_LE(kMaxFramerate - 1, count_);
+        EXPECT_GE(kMaxFramerate + 1, count_);
+
+        // The failed capture is ignored.
+        const int count = count_;
+        clock_.AdvanceTime(TimeDelta::Seconds(1));
+        scheduler_->OnFrameCaptured(nullptr);
+        EXPECT_EQ(count, count_);
+
+        scheduler_ = nullptr;
+    }
 }
 }
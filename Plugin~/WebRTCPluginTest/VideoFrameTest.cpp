@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "GpuMemoryBuffer.h"
+#include "VideoFrameAdapter.h"
 #include "VideoFrameUtil.h"
 
 #include "GraphicsDevice/ITexture2D.h"
@@ -49,6 +50,96 @@ namespace webrtc
         ASSERT_NE(videoFrame, nullptr);
     }
 
+    TEST_P(VideoFrameTest, GetMappedFrameBuffer)
+    {
+        std::unique_ptr<ITexture2D> tex =
+            std::unique_ptr<ITexture2D>(device_->CreateDefaultTextureV(kWidth, kHeight, kFormat));
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        rtc::scoped_refptr<VideoFrame> videoFrame = CreateTestFrame(device_, tex.get(), kFormat);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        ASSERT_NE(videoFrame, nullptr);
+
+        ::webrtc::VideoFrame frame = VideoFrameAdapter::CreateVideoFrame(videoFrame);
+        rtc::scoped_refptr<VideoFrameBuffer> buffer = frame.video_frame_buffer();
+
+        // The first supported type in the list is preferred.
+        VideoFrameBuffer::Type nv12[] = { VideoFrameBuffer::Type::kNV12, VideoFrameBuffer::Type::kI420 };
+        auto mapped = buffer->GetMappedFrameBuffer(nv12);
+        ASSERT_NE(mapped, nullptr);
+        EXPECT_EQ(mapped->type(), VideoFrameBuffer::Type::kNV12);
+        EXPECT_EQ(mapped->width(), static_cast<int>(kWidth));
+        EXPECT_EQ(mapped->height(), static_cast<int>(kHeight));
+
+        VideoFrameBuffer::Type i420[] = { VideoFrameBuffer::Type::kI420, VideoFrameBuffer::Type::kNV12 };
+        mapped = buffer->GetMappedFrameBuffer(i420);
+        ASSERT_NE(mapped, nullptr);
+        EXPECT_EQ(mapped->type(), VideoFrameBuffer::Type::kI420);
+
+        auto scaled = buffer->Scale(kWidth / 2, kHeight / 2);
+        mapped = scaled->GetMappedFrameBuffer(nv12);
+        ASSERT_NE(mapped, nullptr);
+        EXPECT_EQ(mapped->type(), VideoFrameBuffer::Type::kNV12);
+        EXPECT_EQ(mapped->width(), static_cast<int>(kWidth / 2));
+        EXPECT_EQ(mapped->height(), static_cast<int>(kHeight / 2));
+    }
+
+    TEST_P(VideoFrameTest, ScaleToMultipleResolutions)
+    {
+        std::unique_ptr<ITexture2D> tex =
+            std::unique_ptr<ITexture2D>(device_->CreateDefaultTextureV(kWidth, kHeight, kFormat));
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        rtc::scoped_refptr<VideoFrame> videoFrame = CreateTestFrame(device_, tex.get(), kFormat);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        ASSERT_NE(videoFrame, nullptr);
+
+        ::webrtc::VideoFrame frame = VideoFrameAdapter::CreateVideoFrame(videoFrame);
+        rtc::scoped_refptr<VideoFrameBuffer> buffer = frame.video_frame_buffer();
+
+        // Request the smallest layer first, like simulcast encoders do.
+        const int sizes[][2] = { { 64, 64 }, { 128, 128 }, { 96, 96 }, { 256, 256 } };
+        for (auto size : sizes)
+        {
+            auto scaled = buffer->Scale(size[0], size[1]);
+            auto i420 = scaled->ToI420();
+            ASSERT_NE(i420, nullptr);
+            EXPECT_EQ(i420->width(), size[0]);
+            EXPECT_EQ(i420->height(), size[1]);
+
+            // The scaled buffer is cached.
+            EXPECT_EQ(i420, buffer->Scale(size[0], size[1])->ToI420());
+        }
+    }
+
+    TEST_P(VideoFrameTest, CropAndScale)
+    {
+        std::unique_ptr<ITexture2D> tex =
+            std::unique_ptr<ITexture2D>(device_->CreateDefaultTextureV(kWidth, kHeight, kFormat));
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        rtc::scoped_refptr<VideoFrame> videoFrame = CreateTestFrame(device_, tex.get(), kFormat);
+        EXPECT_TRUE(device_->WaitIdleForTest());
+        ASSERT_NE(videoFrame, nullptr);
+
+        ::webrtc::VideoFrame frame = VideoFrameAdapter::CreateVideoFrame(videoFrame);
+        rtc::scoped_refptr<VideoFrameBuffer> buffer = frame.video_frame_buffer();
+
+        const int cropWidth = static_cast<int>(kWidth / 2);
+        const int cropHeight = static_cast<int>(kHeight / 2);
+        auto cropped = buffer->CropAndScale(1, 1, cropWidth, cropHeight, cropWidth / 2, cropHeight / 2);
+        auto scaled = static_cast<VideoFrameAdapter::ScaledBuffer*>(cropped.get());
+        EXPECT_EQ(scaled->crop(), Rect(1, 1, cropWidth, cropHeight));
+
+        auto i420 = cropped->ToI420();
+        ASSERT_NE(i420, nullptr);
+        EXPECT_EQ(i420->width(), cropWidth / 2);
+        EXPECT_EQ(i420->height(), cropHeight / 2);
+
+        // Cropping the cropped buffer is mapped to the rectangle on the original frame.
+        auto nested = cropped->CropAndScale(2, 2, cropWidth / 4, cropHeight / 4, cropWidth / 4, cropHeight / 4);
+        EXPECT_EQ(
+            static_cast<VideoFrameAdapter::ScaledBuffer*>(nested.get())->crop(),
+            Rect(5, 5, cropWidth / 2, cropHeight / 2));
+    }
+
     INSTANTIATE_TEST_SUITE_P(GfxDevice, VideoFrameTest, testing::ValuesIn(supportedGfxDevices));
 
 } // end namespace webrtc
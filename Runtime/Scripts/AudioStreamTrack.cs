@@ -1,4 +1,6 @@
 using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
 using Unity.Collections;
 using Unity.Collections.LowLevel.Unsafe;
 using UnityEngine;
@@ -316,6 +318,59 @@ namespace Unity.WebRTC
             source.Update(array, sampleRate, channels, frames);
         }
 
+        [ThreadStatic]
+        static AudioSourceBatchEntry[] s_batchEntries;
+
+        /// <summary>
+        /// Passes the audio of multiple tracks to the native plugin in one call, instead of calling
+        /// <see cref="SetData(ref NativeArray{float}, int, int)"/> for each track.
+        /// </summary>
+        /// <remarks>
+        /// The buffer of the entries is kept for each thread, so the method does not allocate after the first call
+        /// with the same number of tracks.
+        /// </remarks>
+        /// <param name="tracks"></param>
+        /// <param name="data">The audio of each track in the same order as <paramref name="tracks"/>.</param>
+        /// <param name="channels"></param>
+        /// <param name="sampleRate"></param>
+        public static void SetData(IReadOnlyList<AudioStreamTrack> tracks, IReadOnlyList<NativeArray<float>> data, int channels, int sampleRate)
+        {
+            if (tracks == null)
+                throw new ArgumentNullException(nameof(tracks));
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+            if (tracks.Count != data.Count)
+                throw new ArgumentException("The number of the tracks and the data must be the same.", nameof(data));
+            if (sampleRate == 0 || channels == 0)
+                throw new ArgumentException($"arguments are invalid values " +
+                    $"sampleRate={sampleRate}, " +
+                    $"channels={channels}");
+
+            int count = tracks.Count;
+            if (s_batchEntries == null || s_batchEntries.Length < count)
+                s_batchEntries = new AudioSourceBatchEntry[count];
+            var entries = s_batchEntries;
+            for (int i = 0; i < count; i++)
+            {
+                if (tracks[i]?._trackSource == null)
+                    throw new ArgumentException($"The track at {i} is not a local track.", nameof(tracks));
+                if (data[i].Length == 0)
+                    throw new ArgumentException($"The data of the track at {i} is empty.", nameof(data));
+                unsafe
+                {
+                    entries[i] = new AudioSourceBatchEntry
+                    {
+                        source = tracks[i]._trackSource.GetSelfOrThrow(),
+                        audioData = (IntPtr)data[i].GetUnsafeReadOnlyPtr(),
+                        sampleRate = sampleRate,
+                        numberOfChannels = channels,
+                        numberOfFrames = data[i].Length
+                    };
+                }
+            }
+            NativeMethods.AudioSourceProcessLocalAudioBatch(entries, count);
+        }
+
         /// <summary>
         /// 
         /// </summary>
@@ -332,6 +387,16 @@ namespace Unity.WebRTC
         }
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct AudioSourceBatchEntry
+    {
+        public IntPtr source;
+        public IntPtr audioData;
+        public int sampleRate;
+        public int numberOfChannels;
+        public int numberOfFrames;
+    }
+
     internal class AudioTrackSource : RefCountedObject
     {
         public AudioTrackSource() : base(WebRTC.Context.CreateAudioTrackSource())
@@ -266,6 +266,38 @@ namespace Unity.WebRTC
         {
             NativeMethods.DataChannelRegisterOnClose(self, channel, callback);
         }
+        public int DataChannelSendBatch(IntPtr channel, RTCDataChannelMessage[] messages, int count)
+        {
+            return NativeMethods.DataChannelSendBatch(self, channel, messages, count);
+        }
+        public void DataChannelSendQueued(IntPtr channel, byte[] bytes, bool binary)
+        {
+            NativeMethods.DataChannelSendQueued(self, channel, bytes, bytes.Length, binary);
+        }
+        public void DataChannelSetBufferedAmountThresholds(IntPtr channel, ulong high, ulong low)
+        {
+            NativeMethods.DataChannelSetBufferedAmountThresholds(self, channel, high, low);
+        }
+        public ulong DataChannelGetQueuedAmount(IntPtr channel)
+        {
+            return NativeMethods.DataChannelGetQueuedAmount(self, channel);
+        }
+        public void DataChannelRegisterOnBufferedAmountLow(IntPtr channel, DelegateNativeOnBufferedAmountLow callback)
+        {
+            NativeMethods.DataChannelRegisterOnBufferedAmountLow(self, channel, callback);
+        }
+        public void DataChannelEnableMessageArena(IntPtr channel, int blockSize, DelegateNativeOnMessagesAvailable callback)
+        {
+            NativeMethods.DataChannelEnableMessageArena(self, channel, blockSize, callback);
+        }
+        public int DataChannelAcquireMessages(IntPtr channel, RTCDataChannelMessage[] messages, int maxCount)
+        {
+            return NativeMethods.DataChannelAcquireMessages(self, channel, messages, maxCount);
+        }
+        public void DataChannelReleaseMessages(IntPtr channel, int count)
+        {
+            NativeMethods.DataChannelReleaseMessages(self, channel, count);
+        }
 
         public IntPtr CreateMediaStream(string label)
         {
@@ -358,11 +390,46 @@ namespace Unity.WebRTC
             return NativeMethods.ContextGetStatsList(self, report, out length, ref types);
         }
 
+        public IntPtr GetStatsList(IntPtr report, uint typeMask, out ulong length, ref IntPtr types)
+        {
+            return NativeMethods.ContextGetStatsListFiltered(self, report, out length, ref types, typeMask);
+        }
+
+        public IntPtr GetStatsSnapshot(IntPtr report, out ulong length)
+        {
+            return NativeMethods.ContextGetStatsSnapshot(self, report, out length);
+        }
+
+        public IntPtr GetStatsSnapshot(IntPtr report, uint typeMask, out ulong length)
+        {
+            return NativeMethods.ContextGetStatsSnapshotFiltered(self, report, out length, typeMask);
+        }
+
         public void DeleteStatsReport(IntPtr report)
         {
             NativeMethods.ContextDeleteStatsReport(self, report);
         }
 
+        public void StartStatsSampler(IntPtr connection, int intervalMs)
+        {
+            NativeMethods.PeerConnectionStartStatsSampler(self, connection, intervalMs);
+        }
+
+        public void StopStatsSampler(IntPtr connection)
+        {
+            NativeMethods.PeerConnectionStopStatsSampler(self, connection);
+        }
+
+        public int ReadStatsSamples(RTCStatsSample[] samples)
+        {
+            return NativeMethods.ContextReadStatsSamples(self, samples, samples.Length);
+        }
+
+        public ulong GetDroppedStatsSampleCount()
+        {
+            return NativeMethods.ContextGetDroppedStatsSampleCount(self);
+        }
+
         public void GetSenderCapabilities(TrackKind kind, out IntPtr capabilities)
         {
             NativeMethods.ContextGetSenderCapabilities(self, kind, out capabilities);
@@ -0,0 +1,143 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace Unity.WebRTC
+{
+    /// <summary>
+    /// Decodes the binary snapshot of the stats report which is written by StatsSnapshotWriter in the native plugin.
+    /// </summary>
+    internal static class StatsSnapshotReader
+    {
+        internal const uint Magic = 0x42545355; // "USTB"
+        internal const ushort Version = 2;
+        internal const uint UnknownStatsType = 0xFFFFFFFF;
+        const byte UndefinedMember = 0x80;
+
+        internal class Stats
+        {
+            public string Id;
+            // The value of RTCStatsType, or UnknownStatsType.
+            public uint Type;
+            public long Timestamp;
+            // The undefined members have null.
+            public Dictionary<string, object> Members;
+        }
+
+        static long ReadHeader(BinaryReader reader, out string[] strings, out uint statsCount)
+        {
+            if (reader.ReadUInt32() != Magic)
+                throw new InvalidDataException("The stats snapshot has an invalid magic.");
+            ushort version = reader.ReadUInt16();
+            if (version != Version)
+                throw new InvalidDataException($"The version of the stats snapshot is not supported: {version}");
+            reader.ReadUInt16();
+            long timestamp = reader.ReadInt64();
+            uint stringCount = reader.ReadUInt32();
+            statsCount = reader.ReadUInt32();
+
+            strings = new string[stringCount];
+            for (int i = 0; i < strings.Length; i++)
+            {
+                int length = (int)reader.ReadUInt32();
+                strings[i] = Encoding.UTF8.GetString(reader.ReadBytes(length));
+            }
+            return timestamp;
+        }
+
+        /// <summary>
+        /// Decodes all the stats in the snapshot in the order of the report.
+        /// </summary>
+        internal static List<Stats> Read(byte[] data)
+        {
+            using (var reader = new BinaryReader(new MemoryStream(data, false)))
+            {
+                ReadHeader(reader, out string[] strings, out uint statsCount);
+                var list = new List<Stats>((int)statsCount);
+                for (uint i = 0; i < statsCount; i++)
+                {
+                    var stats = new Stats
+                    {
+                        Id = strings[reader.ReadUInt32()],
+                        Type = reader.ReadUInt32(),
+                        Timestamp = reader.ReadInt64(),
+                    };
+                    uint memberCount = reader.ReadUInt32();
+                    stats.Members = new Dictionary<string, object>((int)memberCount);
+                    for (uint j = 0; j < memberCount; j++)
+                    {
+                        string name = strings[reader.ReadUInt32()];
+                        byte type = reader.ReadByte();
+                        stats.Members[name] = (type & UndefinedMember) != 0
+                            ? null
+                            : ReadValue(reader, (StatsMemberType)type, strings);
+                    }
+                    list.Add(stats);
+                }
+                return list;
+            }
+        }
+
+        static object ReadValue(BinaryReader reader, StatsMemberType type, string[] strings)
+        {
+            switch (type)
+            {
+                case StatsMemberType.Bool:
+                    return reader.ReadByte() != 0;
+                case StatsMemberType.Int32:
+                    return reader.ReadInt32();
+                case StatsMemberType.Uint32:
+                    return reader.ReadUInt32();
+                case StatsMemberType.Int64:
+                    return reader.ReadInt64();
+                case StatsMemberType.Uint64:
+                    return reader.ReadUInt64();
+                case StatsMemberType.Double:
+                    return reader.ReadDouble();
+                case StatsMemberType.String:
+                    return strings[reader.ReadUInt32()];
+                case StatsMemberType.SequenceBool:
+                    return ReadArray(reader, r => r.ReadByte() != 0);
+                case StatsMemberType.SequenceInt32:
+                    return ReadArray(reader, r => r.ReadInt32());
+                case StatsMemberType.SequenceUint32:
+                    return ReadArray(reader, r => r.ReadUInt32());
+                case StatsMemberType.SequenceInt64:
+                    return ReadArray(reader, r => r.ReadInt64());
+                case StatsMemberType.SequenceUint64:
+                    return ReadArray(reader, r => r.ReadUInt64());
+                case StatsMemberType.SequenceDouble:
+                    return ReadArray(reader, r => r.ReadDouble());
+                case StatsMemberType.SequenceString:
+                    return ReadArray(reader, r => strings[r.ReadUInt32()]);
+                case StatsMemberType.MapStringUint64:
+                    return ReadMap(reader, strings, r => r.ReadUInt64());
+                case StatsMemberType.MapStringDouble:
+                    return ReadMap(reader, strings, r => r.ReadDouble());
+                default:
+                    throw new InvalidDataException($"The type of the stats member is unknown: {type}");
+            }
+        }
+
+        static T[] ReadArray<T>(BinaryReader reader, Func<BinaryReader, T> readElement)
+        {
+            var array = new T[reader.ReadUInt32()];
+            for (int i = 0; i < array.Length; i++)
+                array[i] = readElement(reader);
+            return array;
+        }
+
+        static Dictionary<string, T> ReadMap<T>(BinaryReader reader, string[] strings, Func<BinaryReader, T> readValue)
+        {
+            uint count = reader.ReadUInt32();
+            var map = new Dictionary<string, T>((int)count);
+            for (uint i = 0; i < count; i++)
+            {
+                string key = strings[reader.ReadUInt32()];
+                map[key] = readValue(reader);
+            }
+            return map;
+        }
+    }
+}
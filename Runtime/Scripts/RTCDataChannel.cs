@@ -89,6 +89,92 @@ namespace Unity.WebRTC
     /// </summary>
     /// <param name="channel"></param>
     public delegate void DelegateOnDataChannel(RTCDataChannel channel);
+    /// <summary>
+    /// Called when the amount of the messages which are buffered and queued falls to the low threshold.
+    /// </summary>
+    /// <seealso cref="RTCDataChannel.SetBufferedAmountThresholds(ulong, ulong)"/>
+    public delegate void DelegateOnBufferedAmountLow();
+    /// <summary>
+    /// Called when messages arrive while no message is waiting to be acquired.
+    /// </summary>
+    /// <seealso cref="RTCDataChannel.EnableMessageArena(int)"/>
+    public delegate void DelegateOnMessagesAvailable();
+
+    /// <summary>
+    /// The view of a message in the native memory.
+    /// </summary>
+    /// <remarks>
+    /// The data of a received message is valid until the message is released by
+    /// <see cref="RTCDataChannel.ReleaseMessages(int)"/>.
+    /// </remarks>
+    /// <seealso cref="RTCDataChannel.AcquireMessages(RTCDataChannelMessage[])"/>
+    /// <seealso cref="RTCDataChannel.SendBatch(RTCDataChannelMessage[], int)"/>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RTCDataChannelMessage
+    {
+        private IntPtr data;
+        private int size;
+        private byte binary;
+
+        /// <summary>
+        /// Creates the view of the message to send. The data is not copied.
+        /// </summary>
+        /// <param name="data"></param>
+        /// <param name="length"></param>
+        /// <param name="binary"></param>
+        public RTCDataChannelMessage(IntPtr data, int length, bool binary)
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length), length, "The length must not be negative.");
+            if (data == IntPtr.Zero && length > 0)
+                throw new ArgumentNullException(nameof(data));
+            this.data = data;
+            this.size = length;
+            this.binary = binary ? (byte)1 : (byte)0;
+        }
+
+        /// <summary>
+        /// The pointer to the data of the message.
+        /// </summary>
+        public IntPtr Data
+        {
+            get { return data; }
+        }
+
+        /// <summary>
+        /// The size of the message in bytes.
+        /// </summary>
+        public int Length
+        {
+            get { return size; }
+        }
+
+        /// <summary>
+        /// Whether the message was sent as binary.
+        /// </summary>
+        public bool Binary
+        {
+            get { return binary != 0; }
+        }
+
+        /// <summary>
+        /// Returns the data of the message without copying it.
+        /// </summary>
+        /// <returns></returns>
+        public NativeArray<byte>.ReadOnly GetData()
+        {
+            unsafe
+            {
+                var arr = NativeArrayUnsafeUtility.ConvertExistingDataToNativeArray<byte>(
+                    data.ToPointer(), size, Allocator.None);
+
+#if ENABLE_UNITY_COLLECTIONS_CHECKS
+                NativeArrayUnsafeUtility.SetAtomicSafetyHandle(ref arr, AtomicSafetyHandle.Create());
+#endif
+                return arr.AsReadOnly();
+            }
+        }
+    }
 
     /// <summary>
     ///
@@ -99,6 +185,8 @@ namespace Unity.WebRTC
         private DelegateOnMessage onMessage;
         private DelegateOnOpen onOpen;
         private DelegateOnClose onClose;
+        private DelegateOnMessagesAvailable onMessagesAvailable;
+        private DelegateOnBufferedAmountLow onBufferedAmountLow;
 
         /// <summary>
         ///
@@ -136,6 +224,38 @@ namespace Unity.WebRTC
             }
         }
 
+        /// <summary>
+        /// Called on the main thread when messages arrive while no message is waiting to be acquired.
+        /// </summary>
+        /// <remarks>
+        /// The delegate is called only after <see cref="EnableMessageArena(int)"/>. It is not called again until
+        /// all the messages are acquired, so the handler should call <see cref="AcquireMessages(RTCDataChannelMessage[])"/>
+        /// until it returns 0.
+        /// </remarks>
+        public DelegateOnMessagesAvailable OnMessagesAvailable
+        {
+            get { return onMessagesAvailable; }
+            set
+            {
+                onMessagesAvailable = value;
+            }
+        }
+
+        /// <summary>
+        /// Called on the main thread when the sum of <see cref="BufferedAmount"/> and <see cref="QueuedAmount"/>
+        /// falls to the low threshold after exceeding it.
+        /// </summary>
+        /// <seealso cref="SendQueued(byte[])"/>
+        /// <seealso cref="SetBufferedAmountThresholds(ulong, ulong)"/>
+        public DelegateOnBufferedAmountLow OnBufferedAmountLow
+        {
+            get { return onBufferedAmountLow; }
+            set
+            {
+                onBufferedAmountLow = value;
+            }
+        }
+
         /// <summary>
         ///
         /// </summary>
@@ -171,6 +291,12 @@ namespace Unity.WebRTC
         /// </summary>
         public ulong BufferedAmount => NativeMethods.DataChannelGetBufferedAmount(GetSelfOrThrow());
 
+        /// <summary>
+        /// The amount of the messages in bytes which are queued by <see cref="SendQueued(byte[])"/> and not passed
+        /// to the channel yet.
+        /// </summary>
+        public ulong QueuedAmount => WebRTC.Context.DataChannelGetQueuedAmount(GetSelfOrThrow());
+
         /// <summary>
         ///
         /// </summary>
@@ -222,6 +348,30 @@ namespace Unity.WebRTC
             });
         }
 
+        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnMessagesAvailable))]
+        static void DataChannelNativeOnMessagesAvailable(IntPtr ptr)
+        {
+            WebRTC.Sync(ptr, () =>
+            {
+                if (WebRTC.Table[ptr] is RTCDataChannel channel)
+                {
+                    channel.onMessagesAvailable?.Invoke();
+                }
+            });
+        }
+
+        [AOT.MonoPInvokeCallback(typeof(DelegateNativeOnBufferedAmountLow))]
+        static void DataChannelNativeOnBufferedAmountLow(IntPtr ptr)
+        {
+            WebRTC.Sync(ptr, () =>
+            {
+                if (WebRTC.Table[ptr] is RTCDataChannel channel)
+                {
+                    channel.onBufferedAmountLow?.Invoke();
+                }
+            });
+        }
+
         internal RTCDataChannel(IntPtr ptr, RTCPeerConnection peerConnection)
             : base(ptr)
         {
@@ -229,6 +379,7 @@ namespace Unity.WebRTC
             WebRTC.Context.DataChannelRegisterOnMessage(self, DataChannelNativeOnMessage);
             WebRTC.Context.DataChannelRegisterOnOpen(self, DataChannelNativeOnOpen);
             WebRTC.Context.DataChannelRegisterOnClose(self, DataChannelNativeOnClose);
+            WebRTC.Context.DataChannelRegisterOnBufferedAmountLow(self, DataChannelNativeOnBufferedAmountLow);
         }
 
         /// <summary>
@@ -376,6 +527,124 @@ namespace Unity.WebRTC
             }
         }
 
+        /// <summary>
+        /// Queues the message without blocking. The queued messages are held until the channel opens, then passed
+        /// to the channel while <see cref="BufferedAmount"/> is below the high threshold. The queue is dropped when
+        /// the channel closes.
+        /// </summary>
+        /// <param name="msg"></param>
+        /// <seealso cref="SetBufferedAmountThresholds(ulong, ulong)"/>
+        /// <seealso cref="OnBufferedAmountLow"/>
+        public void SendQueued(byte[] msg)
+        {
+            if (msg == null)
+            {
+                throw new ArgumentNullException(nameof(msg));
+            }
+            WebRTC.Context.DataChannelSendQueued(GetSelfOrThrow(), msg, true);
+        }
+
+        /// <summary>
+        /// Queues the string message without blocking.
+        /// </summary>
+        /// <param name="msg"></param>
+        /// <seealso cref="SendQueued(byte[])"/>
+        public void SendQueued(string msg)
+        {
+            if (msg == null)
+            {
+                throw new ArgumentNullException(nameof(msg));
+            }
+            WebRTC.Context.DataChannelSendQueued(GetSelfOrThrow(), System.Text.Encoding.UTF8.GetBytes(msg), false);
+        }
+
+        /// <summary>
+        /// Sets the thresholds of the messages which are queued by <see cref="SendQueued(byte[])"/>.
+        /// </summary>
+        /// <param name="high">The queued messages are passed to the channel while <see cref="BufferedAmount"/> is below this value.</param>
+        /// <param name="low"><see cref="OnBufferedAmountLow"/> is called when the sum of <see cref="BufferedAmount"/>
+        /// and <see cref="QueuedAmount"/> falls to this value.</param>
+        public void SetBufferedAmountThresholds(ulong high, ulong low)
+        {
+            if (low > high)
+            {
+                throw new ArgumentException("The low threshold must not be higher than the high threshold.", nameof(low));
+            }
+            WebRTC.Context.DataChannelSetBufferedAmountThresholds(GetSelfOrThrow(), high, low);
+        }
+
+        /// <summary>
+        /// Sends the first <paramref name="count"/> messages in <paramref name="messages"/> with one call into the
+        /// native plugin. The messages are copied before the method returns.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">
+        /// The method throws <c>InvalidOperationException</c> when <see cref="ReadyState"/>
+        ///  is not <b>Open</b>.
+        /// </exception>
+        /// <param name="messages"></param>
+        /// <param name="count"></param>
+        /// <returns>The number of the sent messages. It is smaller than <paramref name="count"/> when the channel
+        /// refuses a message, for example when its buffer is full.</returns>
+        public int SendBatch(RTCDataChannelMessage[] messages, int count)
+        {
+            if (ReadyState != RTCDataChannelState.Open)
+            {
+                throw new InvalidOperationException("DataChannel is not open");
+            }
+            if (messages == null)
+            {
+                throw new ArgumentNullException(nameof(messages));
+            }
+            if (count < 0 || count > messages.Length)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count), count, "The count is out of the range of the messages.");
+            }
+            return WebRTC.Context.DataChannelSendBatch(GetSelfOrThrow(), messages, count);
+        }
+
+        /// <summary>
+        /// Keeps the received messages in the native memory instead of passing a new array to <see cref="OnMessage"/>
+        /// for each message. The messages are read by <see cref="AcquireMessages(RTCDataChannelMessage[])"/> and
+        /// released by <see cref="ReleaseMessages(int)"/>.
+        /// </summary>
+        /// <remarks>
+        /// <see cref="OnMessage"/> is not called after this method. <see cref="OnMessagesAvailable"/> is called instead.
+        /// </remarks>
+        /// <param name="blockSize">The size of the native blocks which keep the messages. 0 uses the default size.</param>
+        public void EnableMessageArena(int blockSize = 0)
+        {
+            if (blockSize < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(blockSize), blockSize, "The block size must not be negative.");
+            }
+            WebRTC.Context.DataChannelEnableMessageArena(GetSelfOrThrow(), blockSize, DataChannelNativeOnMessagesAvailable);
+        }
+
+        /// <summary>
+        /// Fills <paramref name="messages"/> with the received messages which have not been acquired yet, in the
+        /// received order. The array can be reused for each call.
+        /// </summary>
+        /// <param name="messages"></param>
+        /// <returns>The number of the filled messages.</returns>
+        public int AcquireMessages(RTCDataChannelMessage[] messages)
+        {
+            if (messages == null)
+            {
+                throw new ArgumentNullException(nameof(messages));
+            }
+            return WebRTC.Context.DataChannelAcquireMessages(GetSelfOrThrow(), messages, messages.Length);
+        }
+
+        /// <summary>
+        /// Releases the <paramref name="count"/> oldest acquired messages. Their data must not be accessed after
+        /// this call.
+        /// </summary>
+        /// <param name="count"></param>
+        public void ReleaseMessages(int count)
+        {
+            WebRTC.Context.DataChannelReleaseMessages(GetSelfOrThrow(), count);
+        }
+
         /// <summary>
         /// 
         /// </summary>
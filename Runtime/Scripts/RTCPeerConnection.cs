@@ -744,6 +744,51 @@ namespace Unity.WebRTC
             return GetStats(callback);
         }
 
+        /// <summary>
+        /// Returns an AsyncOperation which resolves with the statistics of the given types only.
+        /// </summary>
+        /// <remarks>
+        /// The native plugin skips the other stats, so polling only the needed types costs less than filtering
+        /// the full report.
+        /// </remarks>
+        /// <param name="types">The types of the stats to report. All the stats are reported if empty.</param>
+        /// <returns>
+        /// An AsyncOperation which resolves with an <see cref="RTCStatsReport"/>
+        /// object providing the statistics of <paramref name="types"/>.
+        /// </returns>
+        /// <seealso cref="RTCStatsReport"/>
+        public RTCStatsReportAsyncOperation GetStats(params RTCStatsType[] types)
+        {
+            RTCStatsCollectorCallback callback = NativeMethods.PeerConnectionGetStats(GetSelfOrThrow());
+            callback.typeMask = RTCStatsReport.GetTypeMask(types);
+            return GetStats(callback);
+        }
+
+        /// <summary>
+        /// Starts collecting the statistics on the interval. The numeric members which changed since the previous
+        /// collection are read by <see cref="WebRTC.ReadStatsSamples(RTCStatsSample[])"/> without building a report.
+        /// </summary>
+        /// <remarks>
+        /// Calling the method again changes the interval.
+        /// </remarks>
+        /// <param name="intervalMs">The interval in milliseconds.</param>
+        public void StartStatsSampler(int intervalMs)
+        {
+            if (intervalMs <= 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(intervalMs), intervalMs, "The interval must be positive.");
+            }
+            WebRTC.Context.StartStatsSampler(GetSelfOrThrow(), intervalMs);
+        }
+
+        /// <summary>
+        /// Stops collecting the statistics which is started by <see cref="StartStatsSampler(int)"/>.
+        /// </summary>
+        public void StopStatsSampler()
+        {
+            WebRTC.Context.StopStatsSampler(GetSelfOrThrow());
+        }
+
         internal RTCStatsReportAsyncOperation GetStats(RTCRtpSender sender)
         {
             RTCStatsCollectorCallback callback = NativeMethods.PeerConnectionSenderGetStats(GetSelfOrThrow(), sender.self);
@@ -1,6 +1,7 @@
 using System;
 using System.Linq;
 using System.Collections.Generic;
+using System.Runtime.InteropServices;
 
 namespace Unity.WebRTC
 {
@@ -192,83 +193,15 @@ namespace Unity.WebRTC
         MapStringDouble // std::map<std::string, double>
     }
 
-    internal class RTCStatsMember
-    {
-        internal IntPtr self;
-
-        internal RTCStatsMember(IntPtr ptr)
-        {
-            self = ptr;
-        }
-
-        internal string GetName()
-        {
-            return NativeMethods.StatsMemberGetName(self).AsAnsiStringWithFreeMem();
-        }
-
-        internal StatsMemberType GetValueType()
-        {
-            return NativeMethods.StatsMemberGetType(self);
-        }
-
-        internal object GetValue()
-        {
-            StatsMemberType type = this.GetValueType();
-
-            if (!NativeMethods.StatsMemberIsDefined(self))
-            {
-                return null;
-            }
-
-            IntPtr values;
-            ulong length = 0;
-            switch (type)
-            {
-                case StatsMemberType.Bool:
-                    return NativeMethods.StatsMemberGetBool(self);
-                case StatsMemberType.Int32:
-                    return NativeMethods.StatsMemberGetInt(self);
-                case StatsMemberType.Uint32:
-                    return NativeMethods.StatsMemberGetUnsignedInt(self);
-                case StatsMemberType.Int64:
-                    return NativeMethods.StatsMemberGetLong(self);
-                case StatsMemberType.Uint64:
-                    return NativeMethods.StatsMemberGetUnsignedLong(self);
-                case StatsMemberType.Double:
-                    return NativeMethods.StatsMemberGetDouble(self);
-                case StatsMemberType.String:
-                    return NativeMethods.StatsMemberGetString(self).AsAnsiStringWithFreeMem();
-                case StatsMemberType.SequenceBool:
-                    return NativeMethods.StatsMemberGetBoolArray(self, out length).AsArray<bool>((int)length);
-                case StatsMemberType.SequenceInt32:
-                    return NativeMethods.StatsMemberGetIntArray(self, out length).AsArray<int>((int)length);
-                case StatsMemberType.SequenceUint32:
-                    return NativeMethods.StatsMemberGetUnsignedIntArray(self, out length).AsArray<uint>((int)length);
-                case StatsMemberType.SequenceInt64:
-                    return NativeMethods.StatsMemberGetLongArray(self, out length).AsArray<long>((int)length);
-                case StatsMemberType.SequenceUint64:
-                    return NativeMethods.StatsMemberGetUnsignedLongArray(self, out length).AsArray<ulong>((int)length);
-                case StatsMemberType.SequenceDouble:
-                    return NativeMethods.StatsMemberGetDoubleArray(self, out length).AsArray<double>((int)length);
-                case StatsMemberType.SequenceString:
-                    return NativeMethods.StatsMemberGetStringArray(self, out length).AsArray<string>((int)length);
-                case StatsMemberType.MapStringUint64:
-                    return NativeMethods.StatsMemberGetMapStringUint64(self, out values, out length).AsMap<ulong>(values, (int)length);
-                case StatsMemberType.MapStringDouble:
-                    return NativeMethods.StatsMemberGetMapStringDouble(self, out values, out length).AsMap<double>(values, (int)length);
-                default:
-                    throw new ArgumentException();
-            }
-        }
-    }
-
     /// <summary>
     /// 
     /// </summary>
     public class RTCStats
     {
         private IntPtr self;
-        internal Dictionary<string, RTCStatsMember> m_members;
+        private readonly RTCStatsType m_type;
+        private readonly string m_id;
+        private readonly long m_timestamp;
         internal Dictionary<string, object> m_dict;
 
         /// <summary>
@@ -276,10 +209,7 @@ namespace Unity.WebRTC
         /// </summary>
         public RTCStatsType Type
         {
-            get
-            {
-                return NativeMethods.StatsGetType(self);
-            }
+            get { return m_type; }
         }
 
         /// <summary>
@@ -287,7 +217,7 @@ namespace Unity.WebRTC
         /// </summary>
         public string Id
         {
-            get { return NativeMethods.StatsGetId(self).AsAnsiStringWithFreeMem(); }
+            get { return m_id; }
         }
 
         /// <summary>
@@ -295,7 +225,7 @@ namespace Unity.WebRTC
         /// </summary>
         public long Timestamp
         {
-            get { return NativeMethods.StatsGetTimestamp(self); }
+            get { return m_timestamp; }
         }
 
         /// <summary>
@@ -311,187 +241,100 @@ namespace Unity.WebRTC
         /// </summary>
         public IDictionary<string, object> Dict
         {
-            get
-            {
-                if (m_dict == null)
-                {
-                    m_dict = m_members.ToDictionary(member => member.Key, member => member.Value.GetValue());
-                }
-
-                return m_dict;
-            }
+            get { return m_dict; }
         }
 
-        internal bool GetBool(string key)
+        // Returns the default value when the member is undefined.
+        T GetValue<T>(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
+            if (!m_dict.TryGetValue(key, out object value) || value == null)
             {
                 return default;
             }
 
-            return NativeMethods.StatsMemberGetBool(m_members[key].self);
+            return (T)value;
         }
 
-        internal int GetInt(string key)
+        internal bool GetBool(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
+            return GetValue<bool>(key);
+        }
 
-            return NativeMethods.StatsMemberGetInt(m_members[key].self);
+        internal int GetInt(string key)
+        {
+            return GetValue<int>(key);
         }
 
         internal uint GetUnsignedInt(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetUnsignedInt(m_members[key].self);
+            return GetValue<uint>(key);
         }
 
         internal long GetLong(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetLong(m_members[key].self);
+            return GetValue<long>(key);
         }
 
         internal ulong GetUnsignedLong(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetUnsignedLong(m_members[key].self);
+            return GetValue<ulong>(key);
         }
 
         internal double GetDouble(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetDouble(m_members[key].self);
+            return GetValue<double>(key);
         }
 
         internal string GetString(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetString(m_members[key].self).AsAnsiStringWithFreeMem();
+            return GetValue<string>(key);
         }
 
         internal bool[] GetBoolArray(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetBoolArray(m_members[key].self, out ulong length)
-                .AsArray<bool>((int)length);
+            return GetValue<bool[]>(key);
         }
 
         internal int[] GetIntArray(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetIntArray(m_members[key].self, out ulong length)
-                .AsArray<int>((int)length);
+            return GetValue<int[]>(key);
         }
 
         internal uint[] GetUnsignedIntArray(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetUnsignedIntArray(m_members[key].self, out ulong length)
-                .AsArray<uint>((int)length);
+            return GetValue<uint[]>(key);
         }
 
         internal long[] GetLongArray(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetLongArray(m_members[key].self, out ulong length)
-                .AsArray<long>((int)length);
+            return GetValue<long[]>(key);
         }
 
         internal ulong[] GetUnsignedLongArray(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetUnsignedLongArray(m_members[key].self, out ulong length)
-                .AsArray<ulong>((int)length);
+            return GetValue<ulong[]>(key);
         }
 
         internal double[] GetDoubleArray(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetDoubleArray(m_members[key].self, out ulong length)
-                .AsArray<double>((int)length);
+            return GetValue<double[]>(key);
         }
 
         internal string[] GetStringArray(string key)
         {
-            if (!NativeMethods.StatsMemberIsDefined(m_members[key].self))
-            {
-                return default;
-            }
-
-            return NativeMethods.StatsMemberGetStringArray(m_members[key].self, out ulong length)
-                .AsArray<string>((int)length);
+            return GetValue<string[]>(key);
         }
 
-        internal RTCStats(IntPtr ptr)
+        /// <summary>
+        /// The members are decoded from the snapshot of the report, so reading them does not call the native plugin.
+        /// </summary>
+        internal RTCStats(IntPtr ptr, StatsSnapshotReader.Stats stats)
         {
             self = ptr;
-            RTCStatsMember[] array = GetMembers();
-            m_members = new Dictionary<string, RTCStatsMember>();
-            foreach (var member in array)
-            {
-                m_members.Add(member.GetName(), member);
-            }
-        }
-
-        RTCStatsMember[] GetMembers()
-        {
-            IntPtr ptr = NativeMethods.StatsGetMembers(self, out ulong length);
-            IntPtr[] array = ptr.AsArray<IntPtr>((int)length);
-
-            RTCStatsMember[] members = new RTCStatsMember[length];
-            for (int i = 0; i < (int)length; i++)
-            {
-                members[i] = new RTCStatsMember(array[i]);
-            }
-
-            return members;
+            m_type = (RTCStatsType)stats.Type;
+            m_id = stats.Id;
+            m_timestamp = stats.Timestamp;
+            m_dict = stats.Members;
         }
 
         /// <summary>
@@ -529,7 +372,7 @@ namespace Unity.WebRTC
         /// </summary>
         public string issuerCertificateId { get { return GetString("issuerCertificateId"); } }
 
-        internal RTCCertificateStats(IntPtr ptr) : base(ptr)
+        internal RTCCertificateStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -569,7 +412,7 @@ namespace Unity.WebRTC
         /// </summary>
         public string sdpFmtpLine { get { return GetString("sdpFmtpLine"); } }
 
-        internal RTCCodecStats(IntPtr ptr) : base(ptr)
+        internal RTCCodecStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -619,7 +462,7 @@ namespace Unity.WebRTC
         /// </summary>
         public ulong bytesReceived { get { return GetUnsignedLong("bytesReceived"); } }
 
-        internal RTCDataChannelStats(IntPtr ptr) : base(ptr)
+        internal RTCDataChannelStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -739,7 +582,7 @@ namespace Unity.WebRTC
         /// </summary>
         public ulong bytesDiscardedOnSend { get { return GetUnsignedLong("bytesDiscardedOnSend"); } }
 
-        internal RTCIceCandidatePairStats(IntPtr ptr) : base(ptr)
+        internal RTCIceCandidatePairStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -815,7 +658,7 @@ namespace Unity.WebRTC
         public string networkAdapterType { get { return GetString("networkAdapterType"); } }
         
         
-        internal RTCIceCandidateStats(IntPtr ptr) : base(ptr)
+        internal RTCIceCandidateStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -836,7 +679,7 @@ namespace Unity.WebRTC
         /// </summary>
         public string[] trackIds { get { return GetStringArray("trackIds"); } }
 
-        internal RTCMediaStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCMediaStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1063,7 +906,7 @@ namespace Unity.WebRTC
         /// </summary>
         public double sumOfSquaredFramesDuration { get { return GetDouble("sumOfSquaredFramesDuration"); } }
 
-        internal RTCMediaStreamTrackStats(IntPtr ptr) : base(ptr)
+        internal RTCMediaStreamTrackStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1085,7 +928,7 @@ namespace Unity.WebRTC
         /// </summary>
         public uint dataChannelsClosed { get { return GetUnsignedInt("dataChannelsClosed"); } }
 
-        internal RTCPeerConnectionStats(IntPtr ptr) : base(ptr)
+        internal RTCPeerConnectionStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1128,7 +971,7 @@ namespace Unity.WebRTC
         [Obsolete("rename to kind")]
         public string mediaType { get { return GetString("mediaType"); } }
 
-        internal RTCRTPStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCRTPStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1148,7 +991,7 @@ namespace Unity.WebRTC
         /// </summary>
         public int packetsLost { get { return GetInt("packetsLost"); } }
 
-        internal RTCReceivedRtpStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCReceivedRtpStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1168,7 +1011,7 @@ namespace Unity.WebRTC
         /// </summary>
         public ulong bytesSent { get { return GetUnsignedLong("bytesSent"); } }
 
-        internal RTCSentRtpStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCSentRtpStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1368,7 +1211,7 @@ namespace Unity.WebRTC
         /// </summary>
         public ulong qpSum { get { return GetUnsignedLong("qpSum"); } }
 
-        internal RTCInboundRTPStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCInboundRTPStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1519,7 +1362,7 @@ namespace Unity.WebRTC
         /// </summary>
         public ulong qpSum { get { return GetUnsignedLong("qpSum"); } }
 
-        internal RTCOutboundRTPStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCOutboundRTPStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1554,7 +1397,7 @@ namespace Unity.WebRTC
         /// </summary>
         public int roundTripTimeMeasurements { get { return GetInt("roundTripTimeMeasurements"); } }
 
-        internal RTCRemoteInboundRtpStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCRemoteInboundRtpStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1579,7 +1422,7 @@ namespace Unity.WebRTC
         /// </summary>
         public ulong reportsSent { get { return GetUnsignedLong("reportsSent"); } }
 
-        internal RTCRemoteOutboundRtpStreamStats(IntPtr ptr) : base(ptr)
+        internal RTCRemoteOutboundRtpStreamStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1599,7 +1442,7 @@ namespace Unity.WebRTC
         /// </summary>
         public string kind { get { return GetString("kind"); } }
 
-        internal RTCMediaSourceStats(IntPtr ptr) : base(ptr)
+        internal RTCMediaSourceStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1624,7 +1467,7 @@ namespace Unity.WebRTC
         /// </summary>
         public double totalSamplesDuration { get { return GetDouble("totalSamplesDuration"); } }
 
-        internal RTCAudioSourceStats(IntPtr ptr) : base(ptr)
+        internal RTCAudioSourceStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1658,7 +1501,7 @@ namespace Unity.WebRTC
         /// </remarks>
         public double framesPerSecond { get { return GetDouble("framesPerSecond"); } }
 
-        internal RTCVideoSourceStats(IntPtr ptr) : base(ptr)
+        internal RTCVideoSourceStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1733,7 +1576,7 @@ namespace Unity.WebRTC
         /// </summary>
         public uint selectedCandidatePairChanges { get { return GetUnsignedInt("selectedCandidatePairChanges"); } }
 
-        internal RTCTransportStats(IntPtr ptr) : base(ptr)
+        internal RTCTransportStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1743,7 +1586,7 @@ namespace Unity.WebRTC
     /// </summary>
     public class RTCTransceiverStats : RTCStats
     {
-        internal RTCTransceiverStats(IntPtr ptr) : base(ptr)
+        internal RTCTransceiverStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1753,7 +1596,7 @@ namespace Unity.WebRTC
     /// </summary>
     public class RTCSenderStats : RTCStats
     {
-        internal RTCSenderStats(IntPtr ptr) : base(ptr)
+        internal RTCSenderStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1763,7 +1606,7 @@ namespace Unity.WebRTC
     /// </summary>
     public class RTCReceiverStats : RTCStats
     {
-        internal RTCReceiverStats(IntPtr ptr) : base(ptr)
+        internal RTCReceiverStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
     }
@@ -1773,7 +1616,7 @@ namespace Unity.WebRTC
     /// </summary>
     public class RTCReceivedRtpStats :RTCStats
     {
-        internal RTCReceivedRtpStats(IntPtr ptr) : base(ptr)
+        internal RTCReceivedRtpStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
 
@@ -1790,7 +1633,7 @@ namespace Unity.WebRTC
 
     public class RTCSentRtpStats : RTCStats
     {
-        internal RTCSentRtpStats(IntPtr ptr) : base(ptr)
+        internal RTCSentRtpStats(IntPtr ptr, StatsSnapshotReader.Stats stats) : base(ptr, stats)
         {
         }
 
@@ -1809,53 +1652,53 @@ namespace Unity.WebRTC
 
     internal class StatsFactory
     {
-        static Dictionary<RTCStatsType, Func<IntPtr, RTCStats>> m_map;
+        static Dictionary<RTCStatsType, Func<IntPtr, StatsSnapshotReader.Stats, RTCStats>> m_map;
 
         static StatsFactory()
         {
-            m_map = new Dictionary<RTCStatsType, Func<IntPtr, RTCStats>>()
+            m_map = new Dictionary<RTCStatsType, Func<IntPtr, StatsSnapshotReader.Stats, RTCStats>>()
             {
-                {RTCStatsType.Codec, ptr => new RTCCodecStats(ptr)},
-                {RTCStatsType.InboundRtp, ptr => new RTCInboundRTPStreamStats(ptr)},
-                {RTCStatsType.OutboundRtp, ptr => new RTCOutboundRTPStreamStats(ptr)},
-                {RTCStatsType.RemoteInboundRtp, ptr => new RTCRemoteInboundRtpStreamStats(ptr)},
-                {RTCStatsType.RemoteOutboundRtp, ptr => new RTCRemoteOutboundRtpStreamStats(ptr)},
+                {RTCStatsType.Codec, (ptr, stats) => new RTCCodecStats(ptr, stats)},
+                {RTCStatsType.InboundRtp, (ptr, stats) => new RTCInboundRTPStreamStats(ptr, stats)},
+                {RTCStatsType.OutboundRtp, (ptr, stats) => new RTCOutboundRTPStreamStats(ptr, stats)},
+                {RTCStatsType.RemoteInboundRtp, (ptr, stats) => new RTCRemoteInboundRtpStreamStats(ptr, stats)},
+                {RTCStatsType.RemoteOutboundRtp, (ptr, stats) => new RTCRemoteOutboundRtpStreamStats(ptr, stats)},
                 {
-                    RTCStatsType.MediaSource, ptr =>
+                    RTCStatsType.MediaSource, (ptr, stats) =>
                     {
-                        var @base = new RTCMediaSourceStats(ptr);
+                        var @base = new RTCMediaSourceStats(ptr, stats);
                         if (@base.kind == "audio")
                         {
-                            return new RTCAudioSourceStats(ptr);
+                            return new RTCAudioSourceStats(ptr, stats);
                         }
 
-                        return new RTCVideoSourceStats(ptr);
+                        return new RTCVideoSourceStats(ptr, stats);
                     }
                 },
-                {RTCStatsType.Csrc, ptr => new RTCCodecStats(ptr)},
-                {RTCStatsType.PeerConnection, ptr => new RTCPeerConnectionStats(ptr)},
-                {RTCStatsType.DataChannel, ptr => new RTCDataChannelStats(ptr)},
+                {RTCStatsType.Csrc, (ptr, stats) => new RTCCodecStats(ptr, stats)},
+                {RTCStatsType.PeerConnection, (ptr, stats) => new RTCPeerConnectionStats(ptr, stats)},
+                {RTCStatsType.DataChannel, (ptr, stats) => new RTCDataChannelStats(ptr, stats)},
 #pragma warning disable 0612
-                {RTCStatsType.Stream, ptr => new RTCMediaStreamStats(ptr)},
-                {RTCStatsType.Track, ptr => new RTCMediaStreamTrackStats(ptr)},
+                {RTCStatsType.Stream, (ptr, stats) => new RTCMediaStreamStats(ptr, stats)},
+                {RTCStatsType.Track, (ptr, stats) => new RTCMediaStreamTrackStats(ptr, stats)},
 #pragma warning restore 0612
-                {RTCStatsType.Transceiver, ptr => new RTCTransceiverStats(ptr)},
-                {RTCStatsType.Sender, ptr => new RTCSenderStats(ptr)},
-                {RTCStatsType.Receiver, ptr => new RTCReceiverStats(ptr)},
-                {RTCStatsType.Transport, ptr => new RTCTransportStats(ptr)},
-                {RTCStatsType.SctpTransport, ptr => new RTCTransportStats(ptr)},
-                {RTCStatsType.CandidatePair, ptr => new RTCIceCandidatePairStats(ptr)},
-                {RTCStatsType.LocalCandidate, ptr => new RTCIceCandidateStats(ptr)},
-                {RTCStatsType.RemoteCandidate, ptr => new RTCIceCandidateStats(ptr)},
-                {RTCStatsType.Certificate, ptr => new RTCCertificateStats(ptr)},
-                {RTCStatsType.ReceivedRtp, ptr => new RTCReceivedRtpStats(ptr)},
-                {RTCStatsType.SentRtp, ptr => new RTCSentRtpStats(ptr)},
+                {RTCStatsType.Transceiver, (ptr, stats) => new RTCTransceiverStats(ptr, stats)},
+                {RTCStatsType.Sender, (ptr, stats) => new RTCSenderStats(ptr, stats)},
+                {RTCStatsType.Receiver, (ptr, stats) => new RTCReceiverStats(ptr, stats)},
+                {RTCStatsType.Transport, (ptr, stats) => new RTCTransportStats(ptr, stats)},
+                {RTCStatsType.SctpTransport, (ptr, stats) => new RTCTransportStats(ptr, stats)},
+                {RTCStatsType.CandidatePair, (ptr, stats) => new RTCIceCandidatePairStats(ptr, stats)},
+                {RTCStatsType.LocalCandidate, (ptr, stats) => new RTCIceCandidateStats(ptr, stats)},
+                {RTCStatsType.RemoteCandidate, (ptr, stats) => new RTCIceCandidateStats(ptr, stats)},
+                {RTCStatsType.Certificate, (ptr, stats) => new RTCCertificateStats(ptr, stats)},
+                {RTCStatsType.ReceivedRtp, (ptr, stats) => new RTCReceivedRtpStats(ptr, stats)},
+                {RTCStatsType.SentRtp, (ptr, stats) => new RTCSentRtpStats(ptr, stats)},
             };
         }
 
-        public static RTCStats Create(RTCStatsType type, IntPtr ptr)
+        public static RTCStats Create(RTCStatsType type, IntPtr ptr, StatsSnapshotReader.Stats stats)
         {
-            return m_map[type](ptr);
+            return m_map[type](ptr, stats);
         }
     }
 
@@ -1869,23 +1712,57 @@ namespace Unity.WebRTC
 
         private bool disposed;
 
-        internal RTCStatsReport(IntPtr ptr)
+        // The mask which does not filter the stats.
+        internal const uint AllStatsTypes = uint.MaxValue;
+
+        internal static uint GetTypeMask(RTCStatsType[] types)
+        {
+            if (types == null || types.Length == 0)
+                return AllStatsTypes;
+            uint mask = 0;
+            foreach (var type in types)
+                mask |= 1u << (int)type;
+            return mask;
+        }
+
+        internal RTCStatsReport(IntPtr ptr) : this(ptr, AllStatsTypes)
+        {
+        }
+
+        // The native plugin skips the stats whose type is not in |typeMask|.
+        internal RTCStatsReport(IntPtr ptr, uint typeMask)
         {
             self = ptr;
             IntPtr ptrStatsTypeArray = IntPtr.Zero;
-            IntPtr ptrStatsArray = WebRTC.Context.GetStatsList(self, out ulong length, ref ptrStatsTypeArray);
+            IntPtr ptrStatsArray = typeMask == AllStatsTypes
+                ? WebRTC.Context.GetStatsList(self, out ulong length, ref ptrStatsTypeArray)
+                : WebRTC.Context.GetStatsList(self, typeMask, out length, ref ptrStatsTypeArray);
             if (ptrStatsArray == IntPtr.Zero)
                 throw new ArgumentException("Invalid pointer.", "ptr");
 
             IntPtr[] array = ptrStatsArray.AsArray<IntPtr>((int)length);
             uint[] types = ptrStatsTypeArray.AsArray<uint>((int)length);
 
+            // The members of all the stats are decoded from one snapshot instead of calling the native plugin for each
+            // member. The snapshot and the list are in the same order, but the list skips the stats of unknown types.
+            IntPtr ptrSnapshot = typeMask == AllStatsTypes
+                ? WebRTC.Context.GetStatsSnapshot(self, out ulong snapshotLength)
+                : WebRTC.Context.GetStatsSnapshot(self, typeMask, out snapshotLength);
+            if (ptrSnapshot == IntPtr.Zero)
+                throw new ArgumentException("Invalid pointer.", "ptr");
+            List<StatsSnapshotReader.Stats> snapshot =
+                StatsSnapshotReader.Read(ptrSnapshot.AsArray<byte>((int)snapshotLength));
+
             m_dictStats = new Dictionary<string, RTCStats>();
-            for (int i = 0; i < (int)length; i++)
+            int i = 0;
+            foreach (var entry in snapshot)
             {
+                if (entry.Type == StatsSnapshotReader.UnknownStatsType)
+                    continue;
                 RTCStatsType type = (RTCStatsType)types[i];
-                RTCStats stats = StatsFactory.Create(type, array[i]);
+                RTCStats stats = StatsFactory.Create(type, array[i], entry);
                 m_dictStats[stats.Id] = stats;
+                i++;
             }
 
             WebRTC.Table.Add(self, this);
@@ -1949,4 +1826,86 @@ namespace Unity.WebRTC
             get { return m_dictStats; }
         }
     }
+
+    /// <summary>
+    /// The numeric member of the stats which changed since the previous sample.
+    /// </summary>
+    /// <seealso cref="RTCPeerConnection.StartStatsSampler(int)"/>
+    /// <seealso cref="WebRTC.ReadStatsSamples(RTCStatsSample[])"/>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RTCStatsSample
+    {
+        private IntPtr connection;
+        private IntPtr statsId;
+        private IntPtr member;
+        private long timestampUs;
+        private double value;
+        private double delta;
+
+        // The member names are static in the native plugin, so the decoded names are kept for the lifetime.
+        static readonly Dictionary<IntPtr, string> s_memberNames = new Dictionary<IntPtr, string>();
+
+        /// <summary>
+        /// The peer connection which reported the stats.
+        /// </summary>
+        public RTCPeerConnection Connection
+        {
+            get { return WebRTC.Table[connection] as RTCPeerConnection; }
+        }
+
+        /// <summary>
+        /// The id of the stats.
+        /// </summary>
+        /// <remarks>
+        /// The string is decoded on each access. It must be read before the next call of
+        /// <see cref="WebRTC.ReadStatsSamples(RTCStatsSample[])"/>.
+        /// </remarks>
+        public string StatsId
+        {
+            get { return Marshal.PtrToStringAnsi(statsId); }
+        }
+
+        /// <summary>
+        /// The name of the member.
+        /// </summary>
+        public string Member
+        {
+            get
+            {
+                lock (s_memberNames)
+                {
+                    if (!s_memberNames.TryGetValue(member, out string name))
+                    {
+                        name = Marshal.PtrToStringAnsi(member);
+                        s_memberNames.Add(member, name);
+                    }
+                    return name;
+                }
+            }
+        }
+
+        /// <summary>
+        /// The timestamp of the stats in microseconds.
+        /// </summary>
+        public long Timestamp
+        {
+            get { return timestampUs; }
+        }
+
+        /// <summary>
+        /// The value of the member.
+        /// </summary>
+        public double Value
+        {
+            get { return value; }
+        }
+
+        /// <summary>
+        /// The difference from the previous sample. 0 for the first sample of the member.
+        /// </summary>
+        public double Delta
+        {
+            get { return delta; }
+        }
+    }
 }
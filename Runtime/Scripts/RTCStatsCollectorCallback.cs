@@ -6,6 +6,8 @@ namespace Unity.WebRTC
     internal class RTCStatsCollectorCallback : SafeHandle
     {
         public Action<RTCStatsReport> onStatsDelivered;
+        // The types of the stats in the report. See RTCStatsReport.GetTypeMask.
+        public uint typeMask = RTCStatsReport.AllStatsTypes;
 
         private RTCStatsCollectorCallback()
             : base(IntPtr.Zero, true)
@@ -747,6 +747,31 @@ namespace Unity.WebRTC
             return false;
         }
 
+        /// <summary>
+        /// Reads the samples which the stats samplers of the peer connections have collected since the previous call.
+        /// </summary>
+        /// <remarks>
+        /// The samples are kept in a bounded buffer, and dropped when they are not read in time.
+        /// The array can be reused for each call.
+        /// </remarks>
+        /// <param name="samples"></param>
+        /// <returns>The number of the read samples.</returns>
+        /// <seealso cref="RTCPeerConnection.StartStatsSampler(int)"/>
+        public static int ReadStatsSamples(RTCStatsSample[] samples)
+        {
+            if (samples == null)
+                throw new ArgumentNullException(nameof(samples));
+            return s_context.ReadStatsSamples(samples);
+        }
+
+        /// <summary>
+        /// The number of the stats samples which have been dropped because they were not read in time.
+        /// </summary>
+        public static ulong DroppedStatsSampleCount
+        {
+            get { return s_context.GetDroppedStatsSampleCount(); }
+        }
+
         /// <summary>
         ///
         /// </summary>
@@ -1119,16 +1144,16 @@ namespace Unity.WebRTC
         {
             Sync(ptr, () =>
             {
-                RTCStatsReport report = WebRTC.FindOrCreate(ptrReport, ptr_ => new RTCStatsReport(ptr_));
-                if (Table[ptr] is RTCPeerConnection connection)
-                {
-                    RTCStatsCollectorCallback callback = connection.FindCollectStatsCallback(ptrCallback);
-                    if (callback == null)
-                        return;
-                    connection.RemoveCollectStatsCallback(callback);
-                    callback.Invoke(report);
-                    callback.Dispose();
-                }
+                // The report is filtered by the types which are requested by the callback.
+                var connection = Table[ptr] as RTCPeerConnection;
+                RTCStatsCollectorCallback callback = connection?.FindCollectStatsCallback(ptrCallback);
+                uint typeMask = callback != null ? callback.typeMask : RTCStatsReport.AllStatsTypes;
+                RTCStatsReport report = WebRTC.FindOrCreate(ptrReport, ptr_ => new RTCStatsReport(ptr_, typeMask));
+                if (callback == null)
+                    return;
+                connection.RemoveCollectStatsCallback(callback);
+                callback.Invoke(report);
+                callback.Dispose();
             });
         }
 
@@ -1212,6 +1237,10 @@ namespace Unity.WebRTC
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void DelegateNativeOnClose(IntPtr ptr);
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void DelegateNativeOnMessagesAvailable(IntPtr ptr);
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void DelegateNativeOnBufferedAmountLow(IntPtr ptr);
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void DelegateNativeMediaStreamOnAddTrack(IntPtr stream, IntPtr track);
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     internal delegate void DelegateNativeMediaStreamOnRemoveTrack(IntPtr stream, IntPtr track);
@@ -1264,6 +1293,20 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextGetStatsList(IntPtr context, IntPtr report, out ulong length, ref IntPtr types);
         [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextGetStatsSnapshot(IntPtr context, IntPtr report, out ulong length);
+        [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextGetStatsListFiltered(IntPtr context, IntPtr report, out ulong length, ref IntPtr types, uint typeMask);
+        [DllImport(WebRTC.Lib)]
+        public static extern IntPtr ContextGetStatsSnapshotFiltered(IntPtr context, IntPtr report, out ulong length, uint typeMask);
+        [DllImport(WebRTC.Lib)]
+        public static extern void PeerConnectionStartStatsSampler(IntPtr context, IntPtr ptr, int intervalMs);
+        [DllImport(WebRTC.Lib)]
+        public static extern void PeerConnectionStopStatsSampler(IntPtr context, IntPtr ptr);
+        [DllImport(WebRTC.Lib)]
+        public static extern int ContextReadStatsSamples(IntPtr context, [In, Out] RTCStatsSample[] samples, int maxCount);
+        [DllImport(WebRTC.Lib)]
+        public static extern ulong ContextGetDroppedStatsSampleCount(IntPtr context);
+        [DllImport(WebRTC.Lib)]
         public static extern void ContextDeleteStatsReport(IntPtr context, IntPtr report);
         [DllImport(WebRTC.Lib)]
         public static extern void ContextAddRefPtr(IntPtr context, IntPtr ptr);
@@ -1451,6 +1494,22 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern void DataChannelRegisterOnClose(IntPtr ctx, IntPtr ptr, DelegateNativeOnClose callback);
         [DllImport(WebRTC.Lib)]
+        public static extern int DataChannelSendBatch(IntPtr ctx, IntPtr ptr, [In] RTCDataChannelMessage[] messages, int count);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelSendQueued(IntPtr ctx, IntPtr ptr, [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 3)] byte[] bytes, int size, [MarshalAs(UnmanagedType.U1)] bool binary);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelSetBufferedAmountThresholds(IntPtr ctx, IntPtr ptr, ulong high, ulong low);
+        [DllImport(WebRTC.Lib)]
+        public static extern ulong DataChannelGetQueuedAmount(IntPtr ctx, IntPtr ptr);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelRegisterOnBufferedAmountLow(IntPtr ctx, IntPtr ptr, DelegateNativeOnBufferedAmountLow callback);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelEnableMessageArena(IntPtr ctx, IntPtr ptr, int blockSize, DelegateNativeOnMessagesAvailable callback);
+        [DllImport(WebRTC.Lib)]
+        public static extern int DataChannelAcquireMessages(IntPtr ctx, IntPtr ptr, [In, Out] RTCDataChannelMessage[] messages, int maxCount);
+        [DllImport(WebRTC.Lib)]
+        public static extern void DataChannelReleaseMessages(IntPtr ctx, IntPtr ptr, int count);
+        [DllImport(WebRTC.Lib)]
         public static extern IntPtr ContextCreateMediaStream(IntPtr ctx, [MarshalAs(UnmanagedType.LPStr, SizeConst = 256)] string label);
         [DllImport(WebRTC.Lib)]
         public static extern void ContextRegisterMediaStreamObserver(IntPtr ctx, IntPtr stream);
@@ -1516,6 +1575,8 @@ namespace Unity.WebRTC
         [DllImport(WebRTC.Lib)]
         public static extern void AudioSourceProcessLocalAudio(IntPtr source, IntPtr array, int sampleRate, int channels, int frames);
         [DllImport(WebRTC.Lib)]
+        public static extern void AudioSourceProcessLocalAudioBatch([In] AudioSourceBatchEntry[] entries, int count);
+        [DllImport(WebRTC.Lib)]
         public static extern IntPtr StatsGetJson(IntPtr stats);
         [DllImport(WebRTC.Lib)]
         public static extern IntPtr StatsGetId(IntPtr stats);
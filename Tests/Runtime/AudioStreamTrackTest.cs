@@ -211,6 +211,30 @@ namespace Unity.WebRTC.RuntimeTest
             UnityEngine.Object.DestroyImmediate(obj);
         }
 
+        [Test]
+        public void AudioStreamTrackSetDataBatch()
+        {
+            var track1 = new AudioStreamTrack();
+            var track2 = new AudioStreamTrack();
+            var tracks = new[] { track1, track2 };
+            var data1 = new NativeArray<float>(2048, Allocator.Temp);
+            var data2 = new NativeArray<float>(2048, Allocator.Temp);
+            var data = new[] { data1, data2 };
+
+            Assert.That(() => AudioStreamTrack.SetData(null, data, 1, 48000), Throws.ArgumentNullException);
+            Assert.That(() => AudioStreamTrack.SetData(tracks, null, 1, 48000), Throws.ArgumentNullException);
+            Assert.That(() => AudioStreamTrack.SetData(tracks, new[] { data1 }, 1, 48000), Throws.ArgumentException);
+            Assert.That(() => AudioStreamTrack.SetData(tracks, data, 0, 48000), Throws.ArgumentException);
+            Assert.That(() => AudioStreamTrack.SetData(tracks, data, 1, 0), Throws.ArgumentException);
+            Assert.That(() => AudioStreamTrack.SetData(tracks, data, 1, 48000), Throws.Nothing);
+            Assert.That(() => AudioStreamTrack.SetData(tracks, data, 2, 48000), Throws.Nothing);
+
+            data1.Dispose();
+            data2.Dispose();
+            track1.Dispose();
+            track2.Dispose();
+        }
+
         //todo(kazuki): workaround ObjectDisposedException for Linux playmode test
         [Test]
         [UnityPlatform(exclude = new[] { RuntimePlatform.LinuxEditor })]
@@ -235,6 +235,145 @@ namespace Unity.WebRTC.RuntimeTest
             Object.DestroyImmediate(test.gameObject);
         }
 
+        [UnityTest]
+        [Timeout(5000)]
+        [UnityPlatform(exclude = new[] { RuntimePlatform.IPhonePlayer })]
+        public IEnumerator SendBatch()
+        {
+            var test = new MonoBehaviourTest<SignalingPeers>();
+            RTCDataChannel channel1 = test.component.CreateDataChannel(0, "test");
+            Assert.That(channel1, Is.Not.Null);
+            yield return test;
+
+            var op1 = new WaitUntilWithTimeout(() => test.component.GetDataChannelList(1).Count > 0, 5000);
+            yield return op1;
+            RTCDataChannel channel2 = test.component.GetDataChannelList(1)[0];
+            Assert.That(channel2, Is.Not.Null);
+
+            var received = new System.Collections.Generic.List<byte[]>();
+            channel2.OnMessage = bytes => { received.Add(bytes); };
+
+            byte[][] payloads = { new byte[] { 1, 2, 3 }, new byte[] { 4 }, new byte[] { 5, 6 } };
+            var messages = new RTCDataChannelMessage[payloads.Length];
+            using (var data = new NativeArray<byte>(6, Allocator.Temp))
+            {
+                var array = data;
+                int offset = 0;
+                for (int i = 0; i < payloads.Length; i++)
+                {
+                    NativeArray<byte>.Copy(payloads[i], 0, array, offset, payloads[i].Length);
+                    unsafe
+                    {
+                        var ptr = IntPtr.Add(new IntPtr(array.GetUnsafeReadOnlyPtr()), offset);
+                        messages[i] = new RTCDataChannelMessage(ptr, payloads[i].Length, true);
+                    }
+                    offset += payloads[i].Length;
+                }
+                Assert.That(() => channel1.SendBatch(null, 0), Throws.ArgumentNullException);
+                Assert.That(() => channel1.SendBatch(messages, messages.Length + 1), Throws.TypeOf<ArgumentOutOfRangeException>());
+                Assert.That(channel1.SendBatch(messages, messages.Length), Is.EqualTo(messages.Length));
+            }
+
+            var op2 = new WaitUntilWithTimeout(() => received.Count >= payloads.Length, 5000);
+            yield return op2;
+            Assert.That(op2.IsCompleted, Is.True);
+            Assert.That(received, Is.EqualTo(payloads));
+
+            test.component.Dispose();
+            Object.DestroyImmediate(test.gameObject);
+        }
+
+        [UnityTest]
+        [Timeout(5000)]
+        [UnityPlatform(exclude = new[] { RuntimePlatform.IPhonePlayer })]
+        public IEnumerator SendQueued()
+        {
+            var test = new MonoBehaviourTest<SignalingPeers>();
+            RTCDataChannel channel1 = test.component.CreateDataChannel(0, "test");
+            Assert.That(channel1, Is.Not.Null);
+            yield return test;
+
+            var op1 = new WaitUntilWithTimeout(() => test.component.GetDataChannelList(1).Count > 0, 5000);
+            yield return op1;
+            RTCDataChannel channel2 = test.component.GetDataChannelList(1)[0];
+            Assert.That(channel2, Is.Not.Null);
+
+            var received = new System.Collections.Generic.List<byte[]>();
+            channel2.OnMessage = bytes => { received.Add(bytes); };
+
+            Assert.That(() => channel1.SetBufferedAmountThresholds(1, 2), Throws.ArgumentException);
+            Assert.That(() => channel1.SendQueued((byte[])null), Throws.ArgumentNullException);
+            channel1.SetBufferedAmountThresholds(1024, 0);
+
+            byte[] message1 = { 1, 2, 3 };
+            const string message2 = "hello";
+            channel1.SendQueued(message1);
+            channel1.SendQueued(message2);
+
+            var op2 = new WaitUntilWithTimeout(() => received.Count >= 2, 5000);
+            yield return op2;
+            Assert.That(op2.IsCompleted, Is.True);
+            Assert.That(received[0], Is.EqualTo(message1));
+            Assert.That(System.Text.Encoding.UTF8.GetString(received[1]), Is.EqualTo(message2));
+            Assert.That(channel1.QueuedAmount, Is.EqualTo(0));
+
+            test.component.Dispose();
+            Object.DestroyImmediate(test.gameObject);
+        }
+
+        [UnityTest]
+        [Timeout(5000)]
+        [UnityPlatform(exclude = new[] { RuntimePlatform.IPhonePlayer })]
+        public IEnumerator ReceiveMessagesFromMessageArena()
+        {
+            var test = new MonoBehaviourTest<SignalingPeers>();
+            RTCDataChannel channel1 = test.component.CreateDataChannel(0, "test");
+            Assert.That(channel1, Is.Not.Null);
+            yield return test;
+
+            var op1 = new WaitUntilWithTimeout(() => test.component.GetDataChannelList(1).Count > 0, 5000);
+            yield return op1;
+            RTCDataChannel channel2 = test.component.GetDataChannelList(1)[0];
+            Assert.That(channel2, Is.Not.Null);
+
+            bool received = false;
+            channel2.OnMessage = bytes => { Assert.Fail("OnMessage must not be called after the arena is enabled."); };
+            channel2.OnMessagesAvailable = () => { received = true; };
+            channel2.EnableMessageArena();
+
+            byte[] message1 = { 1, 2, 3 };
+            const string message2 = "hello";
+            channel1.Send(message1);
+            channel1.Send(message2);
+
+            // The acquired messages stay valid until they are released, so they are collected across the frames.
+            var buffer = new RTCDataChannelMessage[4];
+            var messages = new System.Collections.Generic.List<RTCDataChannelMessage>();
+            var op2 = new WaitUntilWithTimeout(() =>
+            {
+                if (received)
+                {
+                    int acquired = channel2.AcquireMessages(buffer);
+                    for (int i = 0; i < acquired; i++)
+                        messages.Add(buffer[i]);
+                }
+                return messages.Count >= 2;
+            }, 5000);
+            yield return op2;
+            Assert.That(op2.IsCompleted, Is.True);
+            Assert.That(messages.Count, Is.EqualTo(2));
+
+            Assert.That(messages[0].Binary, Is.True);
+            Assert.That(messages[0].GetData().ToArray(), Is.EqualTo(message1));
+            Assert.That(messages[1].Binary, Is.False);
+            Assert.That(System.Text.Encoding.UTF8.GetString(messages[1].GetData().ToArray()), Is.EqualTo(message2));
+            channel2.ReleaseMessages(messages.Count);
+            Assert.That(channel2.AcquireMessages(buffer), Is.EqualTo(0));
+
+            test.component.Dispose();
+            Object.DestroyImmediate(test.gameObject);
+        }
+
         [UnityTest]
         [Timeout(5000)]
         [UnityPlatform(exclude = new[] { RuntimePlatform.IPhonePlayer })]
@@ -1090,6 +1090,79 @@ namespace Unity.WebRTC.RuntimeTest
             Object.DestroyImmediate(test.gameObject);
         }
 
+        [UnityTest]
+        [Timeout(5000)]
+        public IEnumerator GetStatsFilteredByType()
+        {
+            var go = new GameObject("Test");
+            var source = go.AddComponent<AudioSource>();
+            source.clip = AudioClip.Create("test", 480, 2, 48000, false);
+            var track = new AudioStreamTrack(source);
+
+            var test = new MonoBehaviourTest<SignalingPeers>();
+            test.component.AddTransceiver(0, track);
+            yield return test;
+            test.component.CoroutineUpdate();
+
+            var op = test.component.GetPeerStats(0, RTCStatsType.OutboundRtp, RTCStatsType.CandidatePair);
+            yield return op;
+            Assert.That(op.IsDone, Is.True);
+            Assert.That(op.Value.Stats, Is.Not.Empty);
+            foreach (var stats in op.Value.Stats.Values)
+            {
+                Assert.That(stats.Type == RTCStatsType.OutboundRtp || stats.Type == RTCStatsType.CandidatePair, Is.True);
+                StatsCheck.Test(stats);
+            }
+            op.Value.Dispose();
+
+            test.component.Dispose();
+            track.Dispose();
+            Object.DestroyImmediate(go);
+            Object.DestroyImmediate(test.gameObject);
+        }
+
+        [UnityTest]
+        [Timeout(5000)]
+        [UnityPlatform(exclude = new[] { RuntimePlatform.IPhonePlayer })]
+        public IEnumerator ReadStatsSamples()
+        {
+            var go = new GameObject("Test");
+            var source = go.AddComponent<AudioSource>();
+            source.clip = AudioClip.Create("test", 480, 2, 48000, false);
+            var track = new AudioStreamTrack(source);
+
+            var test = new MonoBehaviourTest<SignalingPeers>();
+            test.component.AddTransceiver(0, track);
+            yield return test;
+            test.component.CoroutineUpdate();
+
+            var samples = new RTCStatsSample[256];
+            Assert.That(() => WebRTC.ReadStatsSamples(null), Throws.ArgumentNullException);
+            test.component.StartStatsSampler(0, 100);
+
+            int count = 0;
+            var op = new WaitUntilWithTimeout(() =>
+            {
+                count = WebRTC.ReadStatsSamples(samples);
+                return count > 0;
+            }, 5000);
+            yield return op;
+            Assert.That(op.IsCompleted, Is.True);
+            for (int i = 0; i < count; i++)
+            {
+                Assert.That(samples[i].Connection, Is.Not.Null);
+                Assert.That(samples[i].StatsId, Is.Not.Empty);
+                Assert.That(samples[i].Member, Is.Not.Empty);
+                Assert.That(samples[i].Timestamp, Is.GreaterThan(0));
+            }
+            test.component.StopStatsSampler(0);
+
+            test.component.Dispose();
+            track.Dispose();
+            Object.DestroyImmediate(go);
+            Object.DestroyImmediate(test.gameObject);
+        }
+
         [UnityTest]
         [Timeout(5000)]
         [UnityPlatform(exclude = new[] { RuntimePlatform.IPhonePlayer })]
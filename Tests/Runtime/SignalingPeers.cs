@@ -62,6 +62,21 @@ namespace Unity.WebRTC.RuntimeTest
             return peers[indexPeer].GetStats();
         }
 
+        public RTCStatsReportAsyncOperation GetPeerStats(int indexPeer, params RTCStatsType[] types)
+        {
+            return peers[indexPeer].GetStats(types);
+        }
+
+        public void StartStatsSampler(int indexPeer, int intervalMs)
+        {
+            peers[indexPeer].StartStatsSampler(intervalMs);
+        }
+
+        public void StopStatsSampler(int indexPeer)
+        {
+            peers[indexPeer].StopStatsSampler();
+        }
+
         public RTCStatsReportAsyncOperation GetSenderStats(int indexPeer, int indexSender)
         {
             return GetPeerSenders(indexPeer).ElementAt(indexSender).GetStats();
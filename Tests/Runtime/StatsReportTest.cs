@@ -1,4 +1,6 @@
 using System;
+using System.IO;
+using System.Text;
 using NUnit.Framework;
 using UnityEngine;
 
@@ -11,6 +13,57 @@ namespace Unity.WebRTC.RuntimeTest
         {
             Assert.That(() => new RTCStatsReport(IntPtr.Zero), Throws.ArgumentException);
         }
+
+        [Test]
+        public void ReadStatsSnapshot()
+        {
+            var stream = new MemoryStream();
+            var writer = new BinaryWriter(stream);
+            string[] strings = { "codec1", "payloadType", "mimeType", "audio/opus", "channels" };
+            writer.Write(StatsSnapshotReader.Magic);
+            writer.Write(StatsSnapshotReader.Version);
+            writer.Write((ushort)0);
+            writer.Write(1000L);
+            writer.Write((uint)strings.Length);
+            writer.Write(1u);
+            foreach (var str in strings)
+            {
+                byte[] bytes = Encoding.UTF8.GetBytes(str);
+                writer.Write((uint)bytes.Length);
+                writer.Write(bytes);
+            }
+            writer.Write(0u);
+            writer.Write((uint)RTCStatsType.Codec);
+            writer.Write(2000L);
+            writer.Write(3u);
+            writer.Write(1u);
+            writer.Write((byte)StatsMemberType.Uint32);
+            writer.Write(111u);
+            writer.Write(2u);
+            writer.Write((byte)StatsMemberType.String);
+            writer.Write(3u);
+            // The undefined member has no value.
+            writer.Write(4u);
+            writer.Write((byte)((byte)StatsMemberType.Uint32 | 0x80));
+
+            var list = StatsSnapshotReader.Read(stream.ToArray());
+            Assert.That(list, Has.Count.EqualTo(1));
+            var stats = new RTCCodecStats(IntPtr.Zero, list[0]);
+            Assert.That(stats.Id, Is.EqualTo("codec1"));
+            Assert.That(stats.Type, Is.EqualTo(RTCStatsType.Codec));
+            Assert.That(stats.Timestamp, Is.EqualTo(2000L));
+            Assert.That(stats.Dict, Has.Count.EqualTo(3));
+            Assert.That(stats.payloadType, Is.EqualTo(111u));
+            Assert.That(stats.mimeType, Is.EqualTo("audio/opus"));
+            Assert.That(stats.Dict["channels"], Is.Null);
+            Assert.That(stats.channels, Is.EqualTo(0u));
+        }
+
+        [Test]
+        public void ReadStatsSnapshotThrowsExceptionWithInvalidData()
+        {
+            Assert.That(() => StatsSnapshotReader.Read(new byte[28]), Throws.TypeOf<InvalidDataException>());
+        }
     }
 
 